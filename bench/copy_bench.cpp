@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <any>
 #include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <variant>
 
 using namespace woid;
 
@@ -46,6 +49,7 @@ static void benchVectorConstructionAndSort(benchmark::State& state) {
         Allocator::reset();
         state.ResumeTiming();
     }
+    state.counters["bytesPerAny"] = sizeof(Any);
 }
 
 template <typename Any>
@@ -85,6 +89,7 @@ BENCHMARK(benchVectorConstructionAndSortInt<
     ->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<TrivialAny<>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<DynamicAny<>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortInt<ThinDynamicAny<>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<std::any>)->Apply(setRange);
 
 BENCHMARK(benchVectorConstructionAndSortInt128<Any<8,
@@ -120,6 +125,7 @@ BENCHMARK(benchVectorConstructionAndSortInt128<TrivialAny<8, Copy::ENABLED, 8, t
     ->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<TrivialAny<16>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<DynamicAny<>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortInt128<ThinDynamicAny<>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<std::any>)->Apply(setRange);
 
 BENCHMARK(benchVectorConstructionAndSortThrowInt<
@@ -140,7 +146,225 @@ BENCHMARK(benchVectorConstructionAndSortThrowInt<
 BENCHMARK(benchVectorConstructionAndSortThrowInt<
               Any<8, Copy::ENABLED, ExceptionGuarantee::STRONG, alignof(void*), FunPtr::DEDICATED>>)
     ->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortThrowInt<Any<8,
+                                                     Copy::ENABLED,
+                                                     ExceptionGuarantee::STRONG_DOUBLE_BUFFER,
+                                                     alignof(void*),
+                                                     FunPtr::COMBINED>>)
+    ->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortThrowInt<Any<8,
+                                                     Copy::ENABLED,
+                                                     ExceptionGuarantee::STRONG_DOUBLE_BUFFER,
+                                                     alignof(void*),
+                                                     FunPtr::DEDICATED>>)
+    ->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortThrowInt<DynamicAny<>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortThrowInt<ThinDynamicAny<>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortThrowInt<TrivialAny<8>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortThrowInt<std::any>)->Apply(setRange);
+// Copies an array of `Any`s into raw memory, with one MemManager call per element or, if
+// `kBatched`, per run of equal types.
+template <typename Any, typename ValueType, bool kBatched>
+static void benchArrayCopy(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::allocator<Any> alloc;
+    auto src = bench_common::wrapInts<Any>(bench_common::makeRandomVector<ValueType>(n));
+    Any* dst = alloc.allocate(n);
+
+    for (auto _ : state) {
+        if constexpr (kBatched) {
+            woid::uninitialized_copy_n(src.data(), n, dst);
+        } else {
+            std::uninitialized_copy_n(src.data(), n, dst);
+        }
+        benchmark::ClobberMemory();
+        state.PauseTiming();
+        std::destroy_n(dst, n);
+        state.ResumeTiming();
+    }
+    alloc.deallocate(dst, n);
+}
+
+template <typename Any, typename ValueType, bool kBatched>
+static void benchArrayDestroy(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::allocator<Any> alloc;
+    auto src = bench_common::wrapInts<Any>(bench_common::makeRandomVector<ValueType>(n));
+    Any* dst = alloc.allocate(n);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::uninitialized_copy_n(src.data(), n, dst);
+        state.ResumeTiming();
+        if constexpr (kBatched) {
+            woid::destroy_n(dst, n);
+        } else {
+            std::destroy_n(dst, n);
+        }
+        benchmark::ClobberMemory();
+    }
+    alloc.deallocate(dst, n);
+}
+
+// A pool of slots reassigned values of the types they already hold.
+template <typename Any, typename ValueType>
+static void benchSameTypeReassign(benchmark::State& state) {
+    size_t n = state.range(0);
+    auto src = bench_common::wrapInts<Any>(bench_common::makeRandomVector<ValueType>(n));
+    auto pool = bench_common::wrapInts<Any>(bench_common::makeRandomVector<ValueType>(n));
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            pool[i] = src[i];
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+// Lookups in a hash table keyed by ints and strings, half of them present.
+template <typename Key>
+static void benchHashLookup(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    auto mkKey = [](int i) { return i % 2 ? Key{i} : Key{std::to_string(i)}; };
+    std::unordered_map<Key, int> map;
+    std::vector<Key> queries;
+    for (int i = 0; i < n; i++) {
+        map.emplace(mkKey(i), i);
+        queries.push_back(mkKey(i));
+        queries.push_back(mkKey(n + i));
+    }
+    std::ranges::shuffle(queries, std::mt19937{});
+
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& q : queries) {
+            found += map.contains(q);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+using HashedAny = AnyBuilder::WithSize<sizeof(std::string)>::WithHash::WithEquality::Build;
+using HashedVariant = std::variant<int, std::string>;
+
+using Int128 = bench_common::Int128;
+
+// Folds over a mix of four types, dispatched by `woid::visit` or by probing with `any_cast`.
+template <typename Storage>
+static void benchVisit(benchmark::State& state) {
+    std::vector<Storage> values;
+    for (int i : bench_common::makeRandomVector<int>(state.range(0))) {
+        switch (i % 4) {
+            case 0:
+                values.emplace_back(i);
+                break;
+            case 1:
+                values.emplace_back(static_cast<double>(i));
+                break;
+            case 2:
+                values.emplace_back(Int128{i});
+                break;
+            default:
+                values.emplace_back(std::to_string(i));
+        }
+    }
+    auto size = Overloads{[](int i) -> size_t { return i; },
+                          [](double d) -> size_t { return d; },
+                          [](const Int128& i) -> size_t { return i.a; },
+                          [](const std::string& s) -> size_t { return s.size(); }};
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (const auto& v : values) {
+            if constexpr (std::is_same_v<Storage, std::any>) {
+                if (auto* i = std::any_cast<int>(&v)) {
+                    sum += size(*i);
+                } else if (auto* d = std::any_cast<double>(&v)) {
+                    sum += size(*d);
+                } else if (auto* i128 = std::any_cast<Int128>(&v)) {
+                    sum += size(*i128);
+                } else {
+                    sum += size(*std::any_cast<std::string>(&v));
+                }
+            } else {
+                sum += woid::visit<int, double, Int128, std::string>(v, size);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(benchArrayCopy<Any<8>, int, false>)->Apply(setRange);
+BENCHMARK(benchArrayCopy<Any<8>, int, true>)->Apply(setRange);
+BENCHMARK(benchArrayCopy<Any<16>, Int128, false>)->Apply(setRange);
+BENCHMARK(benchArrayCopy<Any<16>, Int128, true>)->Apply(setRange);
+BENCHMARK(benchArrayCopy<Any<8>, Int128, false>)->Apply(setRange);
+BENCHMARK(benchArrayCopy<Any<8>, Int128, true>)->Apply(setRange);
+
+BENCHMARK(benchArrayDestroy<Any<8>, int, false>)->Apply(setRange);
+BENCHMARK(benchArrayDestroy<Any<8>, int, true>)->Apply(setRange);
+BENCHMARK(benchArrayDestroy<Any<8>, Int128, false>)->Apply(setRange);
+BENCHMARK(benchArrayDestroy<Any<8>, Int128, true>)->Apply(setRange);
+
+BENCHMARK(benchSameTypeReassign<Any<8>, Int128>)->Apply(setRange);
+BENCHMARK(benchSameTypeReassign<Any<16>, Int128>)->Apply(setRange);
+BENCHMARK(benchSameTypeReassign<DynamicAny<>, Int128>)->Apply(setRange);
+BENCHMARK(benchSameTypeReassign<std::any, Int128>)->Apply(setRange);
+
+BENCHMARK(benchVisit<Any<16>>)->Apply(setRange);
+BENCHMARK(benchVisit<std::any>)->Apply(setRange);
+
+BENCHMARK(benchHashLookup<HashedAny>)->Apply(setRange);
+BENCHMARK(benchHashLookup<HashedVariant>)->Apply(setRange);
+
+// Sums `any_cast<int&>` over ints, with the type check set by `SafeAnyCast`. The types match, so
+// the check is a pointer compare.
+template <typename Storage>
+static void benchCheckedAnyCast(benchmark::State& state) {
+    auto ints = bench_common::makeRandomVector<int>(state.range(0));
+    auto values = bench_common::wrapInts<Storage>(ints);
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (auto& v : values) {
+            sum += any_cast<int&>(v);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// Sums the ints of a mix of ints and floats found with `try_cast`. With TYPE_NAME a mismatch also
+// compares the hashes of the type names.
+template <typename Storage>
+static void benchTryCast(benchmark::State& state) {
+    std::vector<Storage> values;
+    for (int i : bench_common::makeRandomVector<int>(state.range(0))) {
+        if (i % 2) {
+            values.emplace_back(i);
+        } else {
+            values.emplace_back(static_cast<float>(i));
+        }
+    }
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (auto& v : values) {
+            if (auto* i = try_cast<int>(v))
+                sum += *i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+using UncheckedAny = AnyBuilder::DisableSafeAnyCast::Build;
+using AddressCheckedAny = AnyBuilder::EnableSafeAnyCast::Build;
+using NameCheckedAny = AnyBuilder::EnableSafeAnyCastByTypeName::Build;
+
+BENCHMARK(benchCheckedAnyCast<UncheckedAny>)->Apply(setRange);
+BENCHMARK(benchCheckedAnyCast<AddressCheckedAny>)->Apply(setRange);
+BENCHMARK(benchCheckedAnyCast<NameCheckedAny>)->Apply(setRange);
+
+BENCHMARK(benchTryCast<AddressCheckedAny>)->Apply(setRange);
+BENCHMARK(benchTryCast<NameCheckedAny>)->Apply(setRange);
+
 BENCHMARK_MAIN();
@@ -1,6 +1,7 @@
 
 #include "common.hpp"
 #include "woid.hpp"
+#include "woid_cpu_dispatch.hpp"
 #include <algorithm>
 #include <benchmark/benchmark.h>
 #include <function2/function2.hpp>
@@ -79,4 +80,55 @@ BENCHMARK(
     ->Apply(setRange);
 BENCHMARK(benchVectorBigLess<std::function<bool(int, int)>>)->Apply(setRange);
 
+// The same vectorizable kernel compiled for each `CpuLevel`. Inlining it into a function targeting
+// a wider instruction set is fine, the other way around is not.
+[[gnu::always_inline]] inline int dot(const int* a, const int* b, size_t n) {
+    int result = 0;
+    for (size_t i = 0; i < n; i++)
+        result += a[i] * b[i];
+    return result;
+}
+
+static int dotScalar(const int* a, const int* b, size_t n) { return dot(a, b, n); }
+
+#if defined(__x86_64__) || defined(__i386__)
+[[gnu::target("sse4.2")]] static int dotSse42(const int* a, const int* b, size_t n) {
+    return dot(a, b, n);
+}
+
+[[gnu::target("avx2")]] static int dotAvx2(const int* a, const int* b, size_t n) {
+    return dot(a, b, n);
+}
+
+[[gnu::target("avx512f")]] static int dotAvx512(const int* a, const int* b, size_t n) {
+    return dot(a, b, n);
+}
+
+using DotDispatch = CpuDispatch<&dotScalar, &dotSse42, &dotAvx2, &dotAvx512>;
+#else
+using DotDispatch = CpuDispatch<&dotScalar>;
+#endif
+
+template <CpuLevel kLevel>
+static void benchDot(benchmark::State& state) {
+    size_t n = state.range(0);
+    auto a = bench_common::makeRandomVector<int>(n);
+    auto b = bench_common::makeRandomVector<int>(n);
+    const Fun<TrivialAny<>, int(const int*, const int*, size_t) const> f{
+        DotDispatch{std::min(kLevel, cpuLevel())}};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f(a.data(), b.data(), n));
+    }
+}
+
+constexpr auto setDotRange = [](auto* bench) -> void {
+    bench->MinWarmUpTime(0.1)->RangeMultiplier(4)->Range(16, 1 << 16);
+};
+
+BENCHMARK(benchDot<CpuLevel::SCALAR>)->Apply(setDotRange);
+BENCHMARK(benchDot<CpuLevel::SSE42>)->Apply(setDotRange);
+BENCHMARK(benchDot<CpuLevel::AVX2>)->Apply(setDotRange);
+BENCHMARK(benchDot<CpuLevel::AVX512>)->Apply(setDotRange);
+
 BENCHMARK_MAIN();
@@ -2,10 +2,14 @@
 #include <algorithm>
 #include <benchmark/benchmark.h>
 #include <boost/te.hpp>
+#include <cmath>
+#include <functional>
 #include <print>
 #include <proxy/proxy.h>
 #include <random>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <variant>
 
 using namespace woid;
@@ -145,6 +149,10 @@ using SharedBase = Builder::WithSharedVTable::Build;
 
 using DedicatedBase = Builder::WithDedicatedVTable::Build;
 
+using UnifiedBase = Builder::WithUnifiedVTable::Build;
+
+using BoxedBase = Builder::WithBoxedStorage<woid::Copy::DISABLED>::Build;
+
 using DedicatedExceptionSafeBase = Builder::WithStorage<
     woid::Any<kRectangleSize, woid::Copy::DISABLED, woid::ExceptionGuarantee::STRONG>>::
     WithDedicatedVTable::Build;
@@ -159,6 +167,34 @@ struct WoidShapeShared : SharedBase {
     double area() const { return call<"area">(); }
 };
 
+struct WoidShapeUnified : UnifiedBase {
+    using UnifiedBase::UnifiedBase;
+    double area() const { return call<"area">(); }
+};
+
+static_assert(sizeof(WoidShapeUnified) + sizeof(void*) == sizeof(WoidShapeShared));
+
+struct WoidShapeBoxed : BoxedBase {
+    using BoxedBase::BoxedBase;
+    double area() const { return call<"area">(); }
+};
+
+static_assert(sizeof(WoidShapeBoxed) == sizeof(std::unique_ptr<VShape>));
+
+// clang-format off
+using BinaryBase = Builder
+           ::BinaryFun<"less",
+                       [](const auto& a, const auto& b) -> bool { return a.area() < b.area(); },
+                       [](const auto& a, const auto& b) -> bool { return a.area() < b.area(); }>
+           ::WithSharedVTable::Build;
+// clang-format on
+
+// Compares the shapes of the same type with a single indirect call.
+struct WoidShapeSharedBinary : BinaryBase {
+    using BinaryBase::BinaryBase;
+    double area() const { return call<"area">(); }
+};
+
 struct WoidShapeDedicated : DedicatedBase {
     using DedicatedBase::DedicatedBase;
     double area() const { return call<"area">(); }
@@ -265,6 +301,12 @@ template <typename T>
     requires(IsProxy<T>)
 constexpr auto kComparator<T> = [](const T& i, const T& j) { return i->area() < j->area(); };
 
+template <>
+constexpr auto kComparator<WoidShapeSharedBinary>
+    = [](const WoidShapeSharedBinary& i, const WoidShapeSharedBinary& j) {
+          return i.callBinary<"less">(j);
+      };
+
 template <typename T>
 constexpr static auto kComparator<std::unique_ptr<T>> =
     [](const std::unique_ptr<T>& i, const std::unique_ptr<T>& j) { return i->area() < j->area(); };
@@ -350,22 +392,89 @@ constexpr auto setRange
 
 BENCHMARK(instantiateAndMinShapes<VShape>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<WoidShapeShared>)->Apply(setRange);
+BENCHMARK(instantiateAndMinShapes<WoidShapeSharedBinary>)->Apply(setRange);
+BENCHMARK(instantiateAndMinShapes<WoidShapeUnified>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<WoidShapeDedicated>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<WoidShapeDedicatedExceptionSafe>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<WoidShapeSharedDynamic>)->Apply(setRange);
+BENCHMARK(instantiateAndMinShapes<WoidShapeBoxed>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<WoidNonTrivialSealedShape>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<BoostTeShape>)->Apply(setRange);
 BENCHMARK(instantiateAndMinShapes<ProxyShape>)->Apply(setRange);
 
 BENCHMARK(instantiateAndSortShapes<VShape>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<WoidShapeShared>)->Apply(setRange);
+BENCHMARK(instantiateAndSortShapes<WoidShapeSharedBinary>)->Apply(setRange);
+BENCHMARK(instantiateAndSortShapes<WoidShapeUnified>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<WoidShapeDedicated>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<WoidShapeDedicatedExceptionSafe>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<WoidShapeSharedDynamic>)->Apply(setRange);
+BENCHMARK(instantiateAndSortShapes<WoidShapeBoxed>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<WoidNonTrivialSealedShape>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<BoostTeShape>)->Apply(setRange);
 BENCHMARK(instantiateAndSortShapes<ProxyShape>)->Apply(setRange);
 
+// A regular polygon whose area is expensive on purpose: the shoelace formula over its vertices.
+struct Polygon {
+    static constexpr int kVertices = 64;
+    double radius;
+
+    double area() const {
+        double result = 0;
+        for (int i = 0; i < kVertices; i++) {
+            const double a = 2 * M_PI * i / kVertices;
+            const double b = 2 * M_PI * (i + 1) / kVertices;
+            result += std::cos(a) * std::sin(b) - std::cos(b) * std::sin(a);
+        }
+        return radius * radius * result / 2;
+    }
+};
+
+using PolygonBuilder
+    = woid::InterfaceBuilder::WithStorage<woid::Any<kRectangleSize, woid::Copy::DISABLED>>;
+
+// clang-format off
+using PolygonBase = PolygonBuilder
+           ::Fun<"area", [](const auto& obj) -> double { return obj.area(); } >
+           ::WithSharedVTable::Build;
+
+using CachedPolygonBase = PolygonBuilder
+           ::CachedFun<"area", [](const auto& obj) -> double { return obj.area(); } >
+           ::WithSharedVTable::Build;
+// clang-format on
+
+struct WoidPolygon : PolygonBase {
+    using PolygonBase::PolygonBase;
+    double area() const { return call<"area">(); }
+};
+
+struct WoidCachedPolygon : CachedPolygonBase {
+    using CachedPolygonBase::CachedPolygonBase;
+    double area() const { return call<"area">(); }
+};
+
+template <typename I>
+static void instantiateAndSortPolygons(benchmark::State& state) {
+    size_t N = state.range(0);
+
+    auto randomRadii = makeRandomDoubles(N);
+    std::vector<I> polygons;
+    polygons.reserve(N);
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        polygons.clear();
+        for (double radius : randomRadii) {
+            polygons.emplace_back(std::in_place_type<Polygon>, radius);
+        }
+        std::ranges::sort(polygons, kComparator<I>);
+        benchmark::DoNotOptimize(polygons.data());
+    }
+}
+
+BENCHMARK(instantiateAndSortPolygons<WoidPolygon>)->Apply(setRange);
+BENCHMARK(instantiateAndSortPolygons<WoidCachedPolygon>)->Apply(setRange);
+
 template <typename I>
 static void instantiateAndMinTrivialShapes(benchmark::State& state) {
     bench<I, true, std::ranges::min_element>(state);
@@ -390,4 +499,53 @@ BENCHMARK(instantiateAndSortTrivialShapes<WoidShapeDedicated>)->Apply(setRange);
 BENCHMARK(instantiateAndSortTrivialShapes<WoidTrivialSealedShape>)->Apply(setRange);
 BENCHMARK(instantiateAndSortTrivialShapes<ProxyTrivialShape>)->Apply(setRange);
 
+static auto makeRandomMethodNames(size_t N) {
+    static const std::array<std::string, 2> kNames{"area", "perimieter"};
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<size_t> distrib(0, kNames.size() - 1);
+    std::vector<std::string> result(N);
+    std::ranges::generate(result, [&]() { return kNames[distrib(gen)]; });
+    return result;
+}
+
+template <typename I, typename Dispatch>
+static void benchCallByName(benchmark::State& state, Dispatch dispatch) {
+    size_t N = state.range(0);
+
+    auto randomDims = makeRandomDoubles(N * 5);
+    std::vector<I> shapes;
+    shapes.reserve(3 * N);
+    kPopulate<I, false>(shapes, randomDims.begin(), N);
+    auto names = makeRandomMethodNames(shapes.size());
+
+    for (auto _ : state) {
+        double sum = 0;
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            sum += dispatch(shapes[i], names[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template <typename I>
+static void callByNamePerfectHash(benchmark::State& state) {
+    benchCallByName<I>(state, [](const I& shape, const std::string& name) {
+        return shape.template callByName<double>(name);
+    });
+}
+
+template <typename I>
+static void callByNameUnorderedMap(benchmark::State& state) {
+    static const std::unordered_map<std::string, std::function<double(const I&)>> kDispatcher{
+        {"area", [](const I& shape) { return shape.template call<"area">(); }},
+        {"perimieter", [](const I& shape) { return shape.template call<"perimieter">(); }},
+    };
+    benchCallByName<I>(state, [](const I& shape, const std::string& name) {
+        return kDispatcher.find(name)->second(shape);
+    });
+}
+
+BENCHMARK(callByNamePerfectHash<WoidShapeShared>)->Apply(setRange);
+BENCHMARK(callByNameUnorderedMap<WoidShapeShared>)->Apply(setRange);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,104 @@
+#include "common.hpp"
+#include "woid.hpp"
+#include "woid_interned.hpp"
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace woid;
+
+// The live heap bytes, counted by the replaced global allocation functions below.
+static std::atomic<size_t> liveBytes{0};
+
+static constexpr size_t kHeader = alignof(std::max_align_t);
+
+void* operator new(size_t n) {
+    auto* p = static_cast<char*>(std::malloc(n + kHeader));
+    if (p == nullptr)
+        std::abort();
+    *reinterpret_cast<size_t*>(p) = n;
+    liveBytes += n;
+    return p + kHeader;
+}
+
+void operator delete(void* p) noexcept {
+    if (p == nullptr)
+        return;
+    auto* base = static_cast<char*>(p) - kHeader;
+    liveBytes -= *reinterpret_cast<size_t*>(base);
+    std::free(base);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+// `n` strings too long for the SBO, `distinctPercent`% of them distinct.
+static std::vector<std::string> makeStream(size_t n, size_t distinctPercent) {
+    const size_t distinct = std::max<size_t>(1, n * distinctPercent / 100);
+    std::vector<std::string> stream;
+    stream.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        stream.push_back("some.config.or.symbol.name."
+                         + std::to_string(bench_common::randInt() % distinct));
+    }
+    return stream;
+}
+
+template <typename Handle>
+static void benchMake(benchmark::State& state) {
+    auto stream = makeStream(state.range(0), state.range(1));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        const size_t before = liveBytes;
+        std::vector<Handle> handles;
+        handles.reserve(stream.size());
+        for (const auto& s : stream) {
+            handles.emplace_back(s);
+        }
+        bytes = liveBytes - before;
+        benchmark::DoNotOptimize(handles.data());
+        state.PauseTiming();
+        handles = {};
+        state.ResumeTiming();
+    }
+    state.counters["bytesPerValue"] = static_cast<double>(bytes) / stream.size();
+}
+
+// Compares each value to the previous one.
+template <typename Handle>
+static void benchEquality(benchmark::State& state) {
+    auto stream = makeStream(state.range(0), state.range(1));
+    std::vector<Handle> handles;
+    for (const auto& s : stream) {
+        handles.emplace_back(s);
+    }
+
+    for (auto _ : state) {
+        size_t equal = 0;
+        for (size_t i = 1; i < handles.size(); i++) {
+            equal += handles[i] == handles[i - 1];
+        }
+        benchmark::DoNotOptimize(equal);
+    }
+}
+
+using Plain = AnyBuilder::WithSize<sizeof(std::string)>::WithEquality::Build;
+using Handle = Interned<Any<sizeof(std::string)>>;
+
+// The number of values and the percentage of them being distinct.
+constexpr auto setArgs = [](auto* bench) -> void {
+    bench->MinWarmUpTime(0.1)->ArgsProduct({{1 << 12, 1 << 16, 1 << 20}, {1, 10, 100}});
+};
+
+BENCHMARK(benchMake<Plain>)->Apply(setArgs);
+BENCHMARK(benchMake<Handle>)->Apply(setArgs);
+
+BENCHMARK(benchEquality<Plain>)->Apply(setArgs);
+BENCHMARK(benchEquality<Handle>)->Apply(setArgs);
+
+BENCHMARK_MAIN();
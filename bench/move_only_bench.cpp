@@ -141,7 +141,9 @@ BENCHMARK(benchVectorConstructionAndSortInt<
 BENCHMARK(benchVectorConstructionAndSortInt<TrivialAny<8, Copy::DISABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<TrivialAny<8, Copy::ENABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<DynamicAny<Copy::DISABLED>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortInt<ThinDynamicAny<Copy::DISABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<DynamicAny<Copy::ENABLED>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortInt<ThinDynamicAny<Copy::ENABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt<std::any>)->Apply(setRange);
 
 BENCHMARK(benchVectorConstructionAndSortInt128<Any<8,
@@ -184,7 +186,9 @@ BENCHMARK(benchVectorConstructionAndSortInt128<TrivialAny<8, Copy::ENABLED, 8, t
 BENCHMARK(benchVectorConstructionAndSortInt128<TrivialAny<16, Copy::DISABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<TrivialAny<16, Copy::ENABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<DynamicAny<Copy::DISABLED>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortInt128<ThinDynamicAny<Copy::DISABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<DynamicAny<Copy::ENABLED>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionAndSortInt128<ThinDynamicAny<Copy::ENABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionAndSortInt128<std::any>)->Apply(setRange);
 
 BENCHMARK(benchVectorConstructionThrowInt<
@@ -224,8 +228,22 @@ BENCHMARK(benchVectorConstructionThrowInt<
 BENCHMARK(benchVectorConstructionThrowInt<
               Any<8, Copy::ENABLED, ExceptionGuarantee::STRONG, alignof(void*), FunPtr::DEDICATED>>)
     ->Apply(setRange);
+BENCHMARK(benchVectorConstructionThrowInt<Any<8,
+                                              Copy::DISABLED,
+                                              ExceptionGuarantee::STRONG_DOUBLE_BUFFER,
+                                              alignof(void*),
+                                              FunPtr::COMBINED>>)
+    ->Apply(setRange);
+BENCHMARK(benchVectorConstructionThrowInt<Any<8,
+                                              Copy::ENABLED,
+                                              ExceptionGuarantee::STRONG_DOUBLE_BUFFER,
+                                              alignof(void*),
+                                              FunPtr::COMBINED>>)
+    ->Apply(setRange);
 BENCHMARK(benchVectorConstructionThrowInt<DynamicAny<Copy::DISABLED>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionThrowInt<ThinDynamicAny<Copy::DISABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionThrowInt<DynamicAny<Copy::ENABLED>>)->Apply(setRange);
+BENCHMARK(benchVectorConstructionThrowInt<ThinDynamicAny<Copy::ENABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionThrowInt<TrivialAny<8, Copy::DISABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionThrowInt<TrivialAny<8, Copy::ENABLED>>)->Apply(setRange);
 BENCHMARK(benchVectorConstructionThrowInt<std::any>)->Apply(setRange);
@@ -0,0 +1,88 @@
+#include "common.hpp"
+#include "woid.hpp"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace woid;
+
+// The message types of a dispatcher, all trivially copyable, of 8, 16 or 24 bytes.
+template <size_t kId>
+struct Message {
+    std::array<uint32_t, 2 * (1 + kId % 3)> payload;
+};
+
+constexpr size_t kTypes = 256;
+
+using PerType = AnyBuilder::WithSize<24>::Build;
+using Shared = AnyBuilder::WithSize<24>::WithSharedThunks::Build;
+
+// The number of distinct lifecycle functions behind the MemManagers of the `kTypes` messages, that
+// is the code the copies below jump into.
+template <typename Storage>
+static size_t distinctThunks() {
+    return []<size_t... kIds>(std::index_sequence<kIds...>) {
+        using Ptr = decltype(Storage::template kMemManagerFor<Message<0>>.ptr);
+        return std::set<Ptr>{Storage::template kMemManagerFor<Message<kIds>>.ptr...}.size();
+    }(std::make_index_sequence<kTypes>{});
+}
+
+// `n` messages of random types.
+template <typename Storage>
+static std::vector<Storage> makeMessages(size_t n) {
+    using Make = Storage (*)(uint32_t);
+    static constexpr auto kMakers = []<size_t... kIds>(std::index_sequence<kIds...>) {
+        return std::array<Make, kTypes>{
+            +[](uint32_t v) { return Storage{Message<kIds>{{v}}}; }...};
+    }(std::make_index_sequence<kTypes>{});
+
+    std::vector<Storage> messages;
+    messages.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        auto v = static_cast<uint32_t>(bench_common::randInt());
+        messages.push_back(kMakers[v % kTypes](v));
+    }
+    return messages;
+}
+
+// Each copy is an indirect call into the function of the message type, so with per-type functions
+// the loop walks over `kTypes` of them.
+template <typename Storage>
+static void benchCopy(benchmark::State& state) {
+    auto messages = makeMessages<Storage>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<Storage> copies{messages};
+        benchmark::DoNotOptimize(copies.data());
+    }
+    state.counters["thunks"] = static_cast<double>(distinctThunks<Storage>());
+}
+
+// Copy-assigns each message to the next one, reusing the slot when the types match.
+template <typename Storage>
+static void benchAssign(benchmark::State& state) {
+    auto messages = makeMessages<Storage>(state.range(0));
+
+    for (auto _ : state) {
+        for (size_t i = 1; i < messages.size(); i++) {
+            messages[i - 1] = messages[i];
+        }
+        benchmark::DoNotOptimize(messages.data());
+    }
+    state.counters["thunks"] = static_cast<double>(distinctThunks<Storage>());
+}
+
+constexpr auto setRange = [](auto* bench) -> void {
+    bench->MinWarmUpTime(0.1)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+};
+
+BENCHMARK(benchCopy<PerType>)->Apply(setRange);
+BENCHMARK(benchCopy<Shared>)->Apply(setRange);
+
+BENCHMARK(benchAssign<PerType>)->Apply(setRange);
+BENCHMARK(benchAssign<Shared>)->Apply(setRange);
+
+BENCHMARK_MAIN();
@@ -2,11 +2,19 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -32,9 +40,24 @@
 #define WOID_NO_ICF
 #endif
 
+// Set if the interfaces and the `FunRef`s over `Ref`/`CRef` can be called in constant expressions.
+// Getting the object takes a cast from `void*`, allowed there since P2738.
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 202306L
+#define WOID_CONSTEXPR_REF 1
+#else
+#define WOID_CONSTEXPR_REF 0
+#endif
+
 namespace woid WOID_SYMBOL_VISIBILITY_FLAG {
 
-enum class ExceptionGuarantee { NONE, BASIC, STRONG };
+// How the assignments of `Any` cope with a throwing copy or move of the object, see the README.
+// `STRONG_DOUBLE_BUFFER` keeps the objects whose move may throw inline, unlike `STRONG`, for which
+// it pays with
+// - a buffer twice as big, `sizeof(Any)` growing by `kSize`;
+// - the moves of the `Any` not being `noexcept`, hence `std::vector` copies on reallocation;
+// - a `swap` of three moves giving the basic guarantee only: if the last one throws, the first
+//   operand holds the object of the second one, which is left empty.
+enum class ExceptionGuarantee { NONE, BASIC, STRONG, STRONG_DOUBLE_BUFFER };
 enum class Copy { ENABLED, DISABLED };
 enum class FunPtr { COMBINED, DEDICATED };
 
@@ -43,9 +66,36 @@ enum class FunPtr { COMBINED, DEDICATED };
 // order for this to work correctly across TU boundary be sure to set symbol visibility to default.
 // Be it for the whole project (with `-fvisibility=default`) or just for Woid with
 // `#define WOID_SYMBOL_VISIBILITY`.
-enum class SafeAnyCast { ENABLED, DISABLED };
+// TYPE_NAME doesn't need that. The MemManager also carries a hash of the type's name, as spelled
+// by the compiler, compared when the addresses differ, e.g. across shared libraries built with
+// `-fvisibility=hidden`. Distinct types spelled alike (such as those in anonymous namespaces of
+// different TUs) are then taken for the same.
+enum class SafeAnyCast { ENABLED, DISABLED, TYPE_NAME };
+
+// Add the hash and the equality of the held object to the MemManager of `Any`, so that it can be a
+// hash table key. Every type stored must then be hashable with `std::hash` or comparable with `==`.
+enum class Hash { DISABLED, ENABLED };
+enum class Equality { DISABLED, ENABLED };
+
+// With SHARED, the trivially copyable and destructible types held inline by `Any` share the
+// lifecycle functions of their size, a memcpy, instead of instantiating their own. This saves code
+// (and i-cache) when many such types are erased. The MemManagers, tiny tables of pointers, are
+// still per type, so `SafeAnyCast`, `visit` and the equality still tell the types apart.
+enum class Thunks { PER_TYPE, SHARED };
 
-enum class VTableOwnership { SHARED, DEDICATED };
+// UNIFIED merges the interface vtable with the storage's MemManager, so that each object carries a
+// single pointer (like a vptr). Only available for `Any` and `Box` storages.
+enum class VTableOwnership { SHARED, DEDICATED, UNIFIED };
+
+// How `CowAny` counts the owners of a block. NON_ATOMIC is for the blocks never shared between
+// threads.
+enum class RefCount { ATOMIC, NON_ATOMIC };
+
+// Where an owning storage puts an object, see `storage_policy`.
+enum class Placement { DEFAULT, INLINE, HEAP, ARENA };
+
+// Whether an SBO storage holds an object inline, and if not, why. See `sbo_report`.
+enum class Sbo { INLINE, TOO_BIG, OVER_ALIGNED, THROWING_MOVE, NOT_TRIVIAL, HEAP_POLICY };
 
 struct TransferOwnership {};
 inline TransferOwnership kTransferOwnership{};
@@ -64,6 +114,43 @@ struct DefaultAllocator {
 
 struct BadAnyCast {};
 
+// Thrown by `callByName` when no method of the given name accepts the given arguments.
+struct UnknownMethod {};
+
+// Whether an object can be moved to another address with a memcpy, the source being abandoned
+// without running its destructor. Specialize it for your own types that qualify, e.g. the handles
+// owning a heap block. Honored by `Any` and `TrivialAny` when the object is stored inline.
+template <typename T>
+struct is_trivially_relocatable
+      : std::bool_constant<(std::is_trivially_move_constructible_v<T>
+                            && std::is_trivially_destructible_v<T>)
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+                           || __builtin_is_cpp_trivially_relocatable(T)
+#elif __has_builtin(__is_trivially_relocatable)
+                           || __is_trivially_relocatable(T)
+#endif
+#endif
+                           > {
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+constexpr inline bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Pins the placement of a `T` in a `Storage`, overriding the size-based choice of the storage.
+// INLINE is a compile error if the object doesn't fit the buffer, or can't be moved as the storage
+// needs. ARENA puts the object in a heap block made by `Arena`, a member of the specialization
+// with the interface of `DefaultAllocator`, and is only honored by `Any`. The storages always on
+// the heap reject INLINE. The `Storage` of an `Any` is its base, `Any<...>::Woid`.
+template <typename T, typename Storage>
+struct storage_policy : std::integral_constant<Placement, Placement::DEFAULT> {};
+
+template <typename T, typename Storage>
+constexpr inline Placement storage_policy_v = storage_policy<T, Storage>::value;
+
 struct Ref;
 struct CRef;
 
@@ -92,6 +179,51 @@ struct TypeTag {
     using Type = T;
 };
 
+// The allocator of the heap blocks of the objects a storage_policy puts there.
+template <typename Policy, typename Alloc>
+struct PolicyAlloc {
+    using Type = Alloc;
+};
+
+template <typename Policy, typename Alloc>
+    requires(Policy::value == Placement::ARENA)
+struct PolicyAlloc<Policy, Alloc> {
+    using Type = Policy::Arena;
+};
+
+constexpr std::uint64_t fnv1a(std::string_view s) {
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (char c : s) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+// The signature of this function, naming `T` the same way in every TU built by the compiler.
+template <typename T>
+consteval std::string_view typeName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+// The address identifies a `T`. Each one points to itself, so no two of them are alike and the
+// linker can't fold them, which `WOID_NO_ICF` can't prevent for variables.
+template <typename T>
+constexpr inline const void* kTypeId = &kTypeId<T>;
+
+// For the storages keeping every object in a heap block of their own allocator.
+template <typename T, typename Storage>
+constexpr void checkHeapOnlyPolicy() {
+    static_assert(storage_policy_v<T, Storage> != Placement::INLINE,
+                  "storage_policy: the storage can't hold the object inline");
+    static_assert(storage_policy_v<T, Storage> != Placement::ARENA,
+                  "storage_policy: the storage doesn't take an arena");
+}
+
 template <typename T>
 inline constexpr TypeTag<T> kTypeTag{};
 
@@ -101,6 +233,9 @@ static constexpr inline bool IsConstRef = std::is_const_v<std::remove_reference_
 template <typename S, typename T>
 using RetainConstPtr = std::conditional_t<IsConstRef<S>, const T*, T*>;
 
+template <typename S, typename T>
+using ForwardedLike = decltype(std::forward_like<S>(std::declval<T&>()));
+
 struct MemManagerTwoPtrs {
   protected:
     using DeletePtr = void (*)(void*);
@@ -138,6 +273,29 @@ template <typename T>
 constexpr inline auto cpyStatic
     = [](void* src, void* dst) static { new (dst) T(*static_cast<T*>(src)); };
 
+// Stands for the trivially copyable and destructible types of `kSize` bytes, see `Thunks::SHARED`.
+template <size_t kSize>
+struct Bytes {
+    std::byte bytes[kSize];
+};
+
+template <typename T>
+using ThunksOf = std::conditional_t<std::is_trivially_copyable_v<T>
+                                        && std::is_trivially_destructible_v<T>,
+                                    Bytes<sizeof(T)>,
+                                    T>;
+
+template <size_t kSize>
+constexpr inline auto delStatic<Bytes<kSize>> = [](void*) static {};
+
+template <size_t kSize>
+constexpr inline auto movStatic<Bytes<kSize>>
+    = [](void* src, void* dst) static { std::memcpy(dst, src, kSize); };
+
+template <size_t kSize>
+constexpr inline auto cpyStatic<Bytes<kSize>>
+    = [](void* src, void* dst) static { std::memcpy(dst, src, kSize); };
+
 constexpr inline auto mkMemManagerTwoPtrsStatic = []<typename T>(TypeTag<T>) consteval static {
     return MemManagerTwoPtrs(delStatic<T>, movStatic<T>);
 };
@@ -242,6 +400,297 @@ constexpr inline auto mkMemManagerOnePtrCpyDynamic
               delDynamic<T, Alloc>, movDynamic<T>, cpyDynamic<T, Alloc>);
       };
 
+// Lifecycle ops on `n` objects of the same type whose storages lie `stride` bytes apart. Let the
+// containers make a single indirect call per run of objects sharing a MemManager instead of one per
+// object.
+struct BatchOps {
+  protected:
+    using DelNPtr = void (*)(void*, size_t, size_t);
+    using MovNPtr = void (*)(void*, void*, size_t, size_t);
+
+  public:
+    void delN(void* first, size_t n, size_t stride) const {
+        std::invoke(delNPtr, first, n, stride);
+    }
+
+    void moveN(void* src, void* dst, size_t n, size_t stride) const {
+        std::invoke(movNPtr, src, dst, n, stride);
+    }
+
+    // Null unless copying is enabled.
+    void cpyN(void* src, void* dst, size_t n, size_t stride) const {
+        std::invoke(cpyNPtr, src, dst, n, stride);
+    }
+
+    DelNPtr delNPtr;
+    MovNPtr movNPtr;
+    MovNPtr cpyNPtr;
+};
+
+inline void* nth(void* first, size_t i, size_t stride) {
+    return static_cast<char*>(first) + i * stride;
+}
+
+template <typename Del, typename Mov, typename Cpy>
+consteval BatchOps mkBatchOpsFromLambdas(Del, Mov, Cpy) {
+    void (*cpyN)(void*, void*, size_t, size_t) = nullptr;
+    if constexpr (!std::is_null_pointer_v<Cpy>) {
+        // If a copy throws, the ones made are destroyed, hence no object is left behind.
+        cpyN = +[](void* src, void* dst, size_t n, size_t stride) static {
+            size_t i = 0;
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                for (; i < n; i++)
+                    Cpy{}(nth(src, i, stride), nth(dst, i, stride));
+#if defined(__cpp_exceptions)
+            } catch (...) {
+                while (i > 0)
+                    Del{}(nth(dst, --i, stride));
+                throw;
+            }
+#endif
+        };
+    }
+    return BatchOps{+[](void* first, size_t n, size_t stride) static {
+                        for (size_t i = 0; i < n; i++)
+                            Del{}(nth(first, i, stride));
+                    },
+                    +[](void* src, void* dst, size_t n, size_t stride) static {
+                        for (size_t i = 0; i < n; i++)
+                            Mov{}(nth(src, i, stride), nth(dst, i, stride));
+                    },
+                    cpyN};
+}
+
+template <Copy kCopy>
+constexpr inline auto mkBatchOpsStatic = []<typename T>(TypeTag<T>) consteval static {
+    if constexpr (kCopy == Copy::ENABLED) {
+        return mkBatchOpsFromLambdas(delStatic<T>, movStatic<T>, cpyStatic<T>);
+    } else {
+        return mkBatchOpsFromLambdas(delStatic<T>, movStatic<T>, nullptr);
+    }
+};
+
+template <Copy kCopy>
+constexpr inline auto mkBatchOpsDynamic
+    = []<typename T, typename Alloc>(TypeTag<T>, TypeTag<Alloc>) consteval static {
+          if constexpr (kCopy == Copy::ENABLED) {
+              return mkBatchOpsFromLambdas(
+                  delDynamic<T, Alloc>, movDynamic<T>, cpyDynamic<T, Alloc>);
+          } else {
+              return mkBatchOpsFromLambdas(delDynamic<T, Alloc>, movDynamic<T>, nullptr);
+          }
+      };
+
+template <typename MM>
+struct WithBatchOps : MM, BatchOps {};
+
+// Makes the MemManager of `mkMM` along with the `BatchOps` of `mkBatch`.
+template <auto mkMM, auto mkBatch>
+constexpr inline auto withBatchOps = []<typename... Tags>(Tags... tags) consteval static {
+    return WithBatchOps<decltype(mkMM(tags...))>{mkMM(tags...), mkBatch(tags...)};
+};
+
+// Assignment to an object of the same type, so that a reused slot keeps its object (and its heap
+// block) instead of destroying it and constructing a new one. A pointer is null if `T` can't be
+// assigned that way or if there is nothing to gain.
+struct AssignOps {
+  protected:
+    using AssignPtr = void (*)(void*, void*);
+
+  public:
+    void cpyAssign(void* src, void* dst) const { std::invoke(cpyAssignPtr, src, dst); }
+
+    // Destroys the object at `src` afterwards.
+    void moveAssign(void* src, void* dst) const { std::invoke(movAssignPtr, src, dst); }
+
+    AssignPtr cpyAssignPtr;
+    AssignPtr movAssignPtr;
+};
+
+template <typename T>
+constexpr inline auto cpyAssignStatic = [](void* src, void* dst) static {
+    *static_cast<T*>(dst) = *static_cast<const T*>(src);
+};
+
+template <typename T>
+constexpr inline auto movAssignStatic = [](void* src, void* dst) static {
+    *static_cast<T*>(dst) = std::move(*static_cast<T*>(src));
+    static_cast<T*>(src)->~T();
+};
+
+template <size_t kSize>
+constexpr inline auto cpyAssignStatic<Bytes<kSize>>
+    = [](void* src, void* dst) static { std::memcpy(dst, src, kSize); };
+
+template <size_t kSize>
+constexpr inline auto movAssignStatic<Bytes<kSize>>
+    = [](void* src, void* dst) static { std::memcpy(dst, src, kSize); };
+
+template <typename T>
+constexpr inline auto cpyAssignDynamic = [](void* src, void* dst) static {
+    **static_cast<T**>(dst) = **static_cast<const T* const*>(src);
+};
+
+template <Copy kCopy>
+constexpr inline auto mkAssignOpsStatic = []<typename T>(TypeTag<T>) consteval static {
+    AssignOps ops{nullptr, nullptr};
+    if constexpr (kCopy == Copy::ENABLED && std::is_copy_assignable_v<T>)
+        ops.cpyAssignPtr = cpyAssignStatic<T>;
+    if constexpr (std::is_move_assignable_v<T>)
+        ops.movAssignPtr = movAssignStatic<T>;
+    return ops;
+};
+
+// Moving the pointer is as cheap as it gets, hence only copying reuses the block.
+template <Copy kCopy>
+constexpr inline auto mkAssignOpsDynamic
+    = []<typename T, typename Alloc>(TypeTag<T>, TypeTag<Alloc>) consteval static {
+          AssignOps ops{nullptr, nullptr};
+          if constexpr (kCopy == Copy::ENABLED && std::is_copy_assignable_v<T>)
+              ops.cpyAssignPtr = cpyAssignDynamic<T>;
+          return ops;
+      };
+
+template <typename MM>
+struct WithAssignOps : MM, AssignOps {};
+
+// Makes the MemManager of `mkMM` along with the `AssignOps` of `mkAssign`.
+template <auto mkMM, auto mkAssign>
+constexpr inline auto withAssignOps = []<typename... Tags>(Tags... tags) consteval static {
+    return WithAssignOps<decltype(mkMM(tags...))>{mkMM(tags...), mkAssign(tags...)};
+};
+
+// The MemManager of `mkMM` along with the batched and the assignment ops.
+template <auto mkMM, Copy kCopy>
+constexpr inline auto withOpsStatic
+    = withAssignOps<withBatchOps<mkMM, mkBatchOpsStatic<kCopy>>, mkAssignOpsStatic<kCopy>>;
+
+template <auto mkMM, Copy kCopy>
+constexpr inline auto withOpsDynamic
+    = withAssignOps<withBatchOps<mkMM, mkBatchOpsDynamic<kCopy>>, mkAssignOpsDynamic<kCopy>>;
+
+// Makes the MemManager of `mkMM` with the functions shared by the trivial types of a size.
+template <auto mkMM, Thunks kThunks>
+constexpr inline auto withThunks = [] consteval {
+    if constexpr (kThunks == Thunks::SHARED) {
+        return []<typename T>(TypeTag<T>) consteval static { return mkMM(kTypeTag<ThunksOf<T>>); };
+    } else {
+        return mkMM;
+    }
+}();
+
+// The hash and the equality of the held objects. Both objects compared are of the same type.
+struct HashOp {
+  protected:
+    using HashPtr = size_t (*)(const void*);
+
+  public:
+    size_t hash(const void* p) const { return std::invoke(hashPtr, p); }
+
+    HashPtr hashPtr;
+};
+
+struct EqualOp {
+  protected:
+    using EqualPtr = bool (*)(const void*, const void*);
+
+  public:
+    bool equal(const void* a, const void* b) const { return std::invoke(equalPtr, a, b); }
+
+    EqualPtr equalPtr;
+};
+
+template <typename T>
+constexpr inline auto hashStatic
+    = [](const void* p) static -> size_t { return std::hash<T>{}(*static_cast<const T*>(p)); };
+
+template <typename T>
+constexpr inline auto hashDynamic = [](const void* p) static -> size_t {
+    return std::hash<T>{}(**static_cast<const T* const*>(p));
+};
+
+template <typename T>
+constexpr inline auto equalStatic = [](const void* a, const void* b) static -> bool {
+    return *static_cast<const T*>(a) == *static_cast<const T*>(b);
+};
+
+template <typename T>
+constexpr inline auto equalDynamic = [](const void* a, const void* b) static -> bool {
+    return **static_cast<const T* const*>(a) == **static_cast<const T* const*>(b);
+};
+
+constexpr inline auto mkHashOpStatic
+    = []<typename T>(TypeTag<T>) consteval static { return HashOp{hashStatic<T>}; };
+
+constexpr inline auto mkHashOpDynamic = []<typename T, typename Alloc>(
+                                            TypeTag<T>, TypeTag<Alloc>) consteval static {
+    return HashOp{hashDynamic<T>};
+};
+
+constexpr inline auto mkEqualOpStatic
+    = []<typename T>(TypeTag<T>) consteval static { return EqualOp{equalStatic<T>}; };
+
+constexpr inline auto mkEqualOpDynamic = []<typename T, typename Alloc>(
+                                             TypeTag<T>, TypeTag<Alloc>) consteval static {
+    return EqualOp{equalDynamic<T>};
+};
+
+template <typename MM>
+struct WithHashOp : MM, HashOp {};
+
+template <typename MM>
+struct WithEqualOp : MM, EqualOp {};
+
+template <auto mkMM, auto mkHash>
+constexpr inline auto withHashOp = []<typename... Tags>(Tags... tags) consteval static {
+    return WithHashOp<decltype(mkMM(tags...))>{mkMM(tags...), mkHash(tags...)};
+};
+
+template <auto mkMM, auto mkEqual>
+constexpr inline auto withEqualOp = []<typename... Tags>(Tags... tags) consteval static {
+    return WithEqualOp<decltype(mkMM(tags...))>{mkMM(tags...), mkEqual(tags...)};
+};
+
+// The MemManager of `mkMM` along with the ops enabled by `kHash` and `kEquality`.
+template <auto mkMM, Hash kHash, Equality kEquality, auto mkHash, auto mkEqual>
+constexpr inline auto withKeyOps = [] consteval {
+    constexpr auto mkHashed = [] consteval {
+        if constexpr (kHash == Hash::ENABLED) {
+            return withHashOp<mkMM, mkHash>;
+        } else {
+            return mkMM;
+        }
+    }();
+    if constexpr (kEquality == Equality::ENABLED) {
+        return withEqualOp<mkHashed, mkEqual>;
+    } else {
+        return mkHashed;
+    }
+}();
+
+// The identity of the held type surviving the copies of the MemManager made by the shared libraries
+// with hidden symbols, see `SafeAnyCast::TYPE_NAME`.
+struct TypeNameOp {
+    std::uint64_t typeNameHash;
+};
+
+template <typename MM>
+struct WithTypeNameOp : MM, TypeNameOp {};
+
+template <auto mkMM, SafeAnyCast kSac>
+constexpr inline auto withTypeName = [] consteval {
+    if constexpr (kSac == SafeAnyCast::TYPE_NAME) {
+        return []<typename T, typename... Tags>(TypeTag<T> tag, Tags... tags) consteval static {
+            return WithTypeNameOp<decltype(mkMM(tag, tags...))>{mkMM(tag, tags...),
+                                                                {fnv1a(typeName<T>())}};
+        };
+    } else {
+        return mkMM;
+    }
+}();
+
 template <typename T, typename Self, typename Void>
 T star(Void* p) {
     return static_cast<T>(*static_cast<RetainConstPtr<Self, std::remove_reference_t<T>>>(p));
@@ -258,6 +707,14 @@ inline void reportBadAnyCast() {
 #endif
 }
 
+[[noreturn]] inline void reportUnknownMethod() {
+#if defined(__cpp_exceptions)
+    throw UnknownMethod{};
+#else
+    std::terminate();
+#endif
+}
+
 template <typename Self, typename S>
 decltype(auto) ptr(S&& s) {
     return static_cast<detail::RetainConstPtr<Self, void>>(
@@ -271,26 +728,92 @@ template <auto mmStaticMaker,
           ExceptionGuarantee kEg,
           Copy kCopy,
           SafeAnyCast kSac,
-          typename Alloc_>
+          typename Alloc_,
+          typename Manager = GetMemManager<withTypeName<mmStaticMaker, kSac>>>
     requires(kSize >= sizeof(void*) && kAlignment >= alignof(void*)) class Woid {
+  public:
+    using MemManager = GetMemManager<withTypeName<mmStaticMaker, kSac>>;
+
   private:
+    static constexpr auto kStaticMaker = withTypeName<mmStaticMaker, kSac>;
+    static constexpr auto kDynamicMaker = withTypeName<mmDynamicMaker, kSac>;
+
     static constexpr bool kIsMoveOnly = kCopy == Copy::DISABLED;
+    static constexpr bool kIsDefaultManager = std::is_same_v<Manager, MemManager>;
+
+    // SafeAnyCast matches the address of the MemManager, while a custom Manager has its own one.
+    static_assert(kIsDefaultManager || kSac == SafeAnyCast::DISABLED);
+
+    // The storage_policy is keyed on the Woid with the default Manager, so that a custom one, which
+    // is initialized from `kMemManagerFor`, agrees on where the objects are.
+    using PolicyKey
+        = Woid<mmStaticMaker, mmDynamicMaker, kSize, kAlignment, kEg, kCopy, kSac, Alloc_>;
+
+    template <typename T>
+    static consteval Sbo sbo() {
+        constexpr auto kPlacement = storage_policy_v<T, PolicyKey>;
+        constexpr auto kFit = sizeof(T) > kSize             ? Sbo::TOO_BIG
+                              : alignof(T) > kAlignment     ? Sbo::OVER_ALIGNED
+                              : kEg == ExceptionGuarantee::STRONG
+                                      && !std::is_nothrow_move_constructible_v<T>
+                                  ? Sbo::THROWING_MOVE
+                                  : Sbo::INLINE;
+        if constexpr (kPlacement == Placement::INLINE) {
+            static_assert(kFit != Sbo::TOO_BIG && kFit != Sbo::OVER_ALIGNED,
+                          "storage_policy: the object doesn't fit the buffer");
+            static_assert(kFit != Sbo::THROWING_MOVE,
+                          "storage_policy: STRONG needs a nothrow move to be inline");
+            return Sbo::INLINE;
+        } else if constexpr (kPlacement != Placement::DEFAULT) {
+            return Sbo::HEAP_POLICY;
+        } else {
+            return kFit;
+        }
+    }
 
-    using MemManager = GetMemManager<mmStaticMaker>;
-    static_assert(std::is_same_v<MemManager, GetMemManager<mmStaticMaker>>);
+    template <typename T>
+    inline static constexpr bool kIsBig = sbo<T>() != Sbo::INLINE;
 
+    // The allocator of the heap block holding a `T`.
     template <typename T>
-    inline static constexpr bool kIsBig
-        = sizeof(T) > kSize
-          || alignof(T) > kAlignment
-          || (kEg == ExceptionGuarantee::STRONG && !std::is_nothrow_move_constructible_v<T>);
+    using AllocFor = PolicyAlloc<storage_policy<T, PolicyKey>, Alloc_>::Type;
 
     template <typename T>
     static constexpr inline auto dynamicMM WOID_NO_ICF
-        = mmDynamicMaker(kTypeTag<T>, kTypeTag<Alloc_>);
+        = kDynamicMaker(kTypeTag<T>, kTypeTag<AllocFor<T>>);
+
+    template <typename T>
+    static constexpr inline auto staticMM WOID_NO_ICF = kStaticMaker(kTypeTag<T>);
+
+    // Set in `mmAndTag` if moving the object is a memcpy of the buffer (it is trivially relocatable
+    // or it is on the heap) and if destroying it is a no-op (it is inline and trivially
+    // destructible). Both are set only if copying is a memcpy too, as for a function pointer.
+    // MemManagers are aligned, so the low bits are always free.
+    static constexpr std::uintptr_t kRelocateBit = 1;
+    static constexpr std::uintptr_t kNoDestroyBit = 2;
+
+    // With `STRONG_DOUBLE_BUFFER` the buffer is doubled. A new object is made in the spare half
+    // while the old one stays intact, and this bit tells which half is in use.
+    static constexpr bool kDoubleBuffer = kEg == ExceptionGuarantee::STRONG_DOUBLE_BUFFER;
+    static constexpr std::uintptr_t kSecondHalfBit = kDoubleBuffer ? 4 : 0;
+
+    static constexpr std::uintptr_t kTagBits = kRelocateBit | kNoDestroyBit | kSecondHalfBit;
+    static_assert(alignof(Manager) > kTagBits);
+
+    // Whether moving the Woid can't throw. Otherwise it might, as the stored object is moved.
+    static constexpr bool kNothrowMove
+        = kEg == ExceptionGuarantee::NONE || kEg == ExceptionGuarantee::STRONG;
 
     template <typename T>
-    static constexpr inline auto staticMM WOID_NO_ICF = mmStaticMaker(kTypeTag<T>);
+    static std::uintptr_t tagged(const Manager* manager) {
+        constexpr bool kRelocate = kIsBig<T> || is_trivially_relocatable_v<T>;
+        constexpr bool kNoDestroy = !kIsBig<T> && std::is_trivially_destructible_v<T>
+                                    && (!kRelocate || kIsMoveOnly
+                                        || std::is_trivially_copy_constructible_v<T>);
+        return std::bit_cast<std::uintptr_t>(manager)
+               | (kRelocate ? kRelocateBit : 0)
+               | (kNoDestroy ? kNoDestroyBit : 0);
+    }
 
   public:
     inline static constexpr auto kExceptionGuarantee = kEg;
@@ -299,101 +822,459 @@ template <auto mmStaticMaker,
     inline static constexpr auto kSafeAnyCast = kSac;
     using Alloc = Alloc_;
 
+    // Whether a `T` is held inline, see `sbo_report`.
+    template <typename T>
+    inline static constexpr Sbo kSbo = sbo<T>();
+
+    // The MemManager handling a T. A custom Manager must be initialized from it.
+    template <typename T>
+    static constexpr inline const MemManager& kMemManagerFor
+        = kIsBig<T> ? dynamicMM<T> : staticMM<T>;
+
+    template <typename NewManager>
+    using WithManager
+        = Woid<mmStaticMaker,
+               mmDynamicMaker,
+               kSize,
+               kAlignment,
+               kEg,
+               kCopy,
+               kSac,
+               Alloc_,
+               NewManager>;
+
     template <typename T>
     explicit Woid(T&& t)
         requires(!std::is_same_v<std::remove_cvref_t<T>, Woid>)
           : Woid(std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(t)) {}
 
+    // Adopts `tPtr`, made by `Alloc`, if a `T` is stored in a block of `Alloc`. Otherwise the
+    // object is moved into the buffer, or the arena, and the block is freed.
     template <typename T>
     explicit Woid(TransferOwnership, T* tPtr)
-        requires(kIsBig<T> && !std::is_const_v<T>) {
-        this->mm = &dynamicMM<T>;
-        *static_cast<void**>(ptr()) = tPtr;
+        requires(!std::is_const_v<T> && kIsDefaultManager)
+          : mmAndTag{tagged<T>(&kMemManagerFor<T>)} {
+        if constexpr (kIsBig<T> && std::is_same_v<AllocFor<T>, Alloc_>) {
+            *static_cast<void**>(ptr()) = tPtr;
+        } else {
+            construct<T>(ptr(), std::move(*tPtr));
+            Alloc::del(tPtr);
+        }
     }
 
     template <typename T, typename... Args>
-    explicit Woid(std::in_place_type_t<T>, Args&&... args) {
-        if constexpr (kIsBig<T>) {
-            this->mm = &dynamicMM<T>;
-            auto* obj = Alloc::template make<T>(std::forward<Args>(args)...);
-            *static_cast<void**>(ptr()) = obj;
-        } else {
-            this->mm = &staticMM<T>;
-            new (ptr()) T(std::forward<Args>(args)...);
-        }
+    explicit Woid(std::in_place_type_t<T> tag, Args&&... args)
+        requires(kIsDefaultManager)
+          : Woid(&kMemManagerFor<T>, tag, std::forward<Args>(args)...) {}
+
+    template <typename T, typename... Args>
+    explicit Woid(const Manager* manager, std::in_place_type_t<T>, Args&&... args)
+          : mmAndTag{tagged<T>(manager)} {
+        construct<T>(ptr(), std::forward<Args>(args)...);
     }
+    // Holds nothing, as if moved from.
+    constexpr Woid() : mmAndTag{0} {}
+
     Woid(const Woid& other)
         requires(!kIsMoveOnly)
-          : mm(other.mm) {
-        mm->cpy(const_cast<void*>(other.ptr()), ptr());
+          : mmAndTag(other.mmAndTag) {
+        copy(other.mmAndTag, other.ptr(), ptr());
     }
+    // An object of the same type is assigned to rather than destroyed and copied, unless the
+    // assignment might throw halfway under a strong guarantee.
     Woid& operator=(const Woid& other)
         requires(!kIsMoveOnly) {
         if constexpr (kEg == ExceptionGuarantee::STRONG) {
             *this = Woid{other};
+        } else if constexpr (kDoubleBuffer) {
+            if (this != &other) {
+                replace(other.mmAndTag,
+                        [&](void* dst) { copy(other.mmAndTag, other.ptr(), dst); });
+            }
+        } else {
+            if (this == &other)
+                return *this;
+            if (mmAndTag == other.mmAndTag && mmAndTag != 0 && !isTriviallyCopyable(mmAndTag)
+                && mm()->cpyAssignPtr) {
+                mm()->cpyAssign(const_cast<void*>(other.ptr()), ptr());
+                return *this;
+            }
+            destroy();
+            if constexpr (kEg == ExceptionGuarantee::BASIC)
+                mmAndTag = 0;
+            copy(other.mmAndTag, other.ptr(), ptr());
+            mmAndTag = other.mmAndTag;
+        }
+        return *this;
+    }
+    Woid(Woid&& other) noexcept(kNothrowMove) { relocateFrom(other); }
+    // Same as the copy, but a memcpy is cheaper still if the object is trivially relocatable.
+    Woid& operator=(Woid&& other) noexcept(kNothrowMove) {
+        if (this == &other)
+            return *this;
+        if constexpr (kDoubleBuffer) {
+            replace(other.mmAndTag,
+                    [&](void* dst) { relocate(other.mmAndTag, other.ptr(), dst); });
+            other.mmAndTag = 0;
+        } else {
+            if constexpr (kEg != ExceptionGuarantee::STRONG) {
+                if (mmAndTag == other.mmAndTag && mmAndTag != 0 && !(mmAndTag & kRelocateBit)
+                    && mm()->movAssignPtr) {
+                    mm()->moveAssign(other.ptr(), ptr());
+                    other.mmAndTag = 0;
+                    return *this;
+                }
+            }
+            destroy();
+            if constexpr (kEg == ExceptionGuarantee::BASIC)
+                mmAndTag = 0;
+            relocateFrom(other);
+        }
+        return *this;
+    }
+    ~Woid() { destroy(); }
+
+    const Manager* getManager() const { return mm(); }
+
+    // Destroys the object, if any, and constructs a `T` in its place. Under a strong guarantee the
+    // new object is constructed aside first.
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args)
+        requires(kIsDefaultManager) {
+        return emplace(&kMemManagerFor<T>, std::in_place_type<T>, std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(const Manager* manager, std::in_place_type_t<T> tag, Args&&... args) {
+        if constexpr (kEg == ExceptionGuarantee::STRONG) {
+            *this = Woid{manager, tag, std::forward<Args>(args)...};
+            return object<T>();
+        } else if constexpr (kDoubleBuffer) {
+            replace(tagged<T>(manager),
+                    [&](void* dst) { construct<T>(dst, std::forward<Args>(args)...); });
+            return object<T>();
+        } else {
+            reset();
+            auto& t = construct<T>(ptr(), std::forward<Args>(args)...);
+            mmAndTag = tagged<T>(manager);
+            return t;
+        }
+    }
+
+    // Destroys the object, if any, leaving the Woid empty as if moved from.
+    void reset() {
+        destroy();
+        mmAndTag = 0;
+    }
+
+    // Gives up the heap block holding the `T`, to be freed by `Alloc`. The Woid is left empty.
+    template <typename T>
+    T* release()
+        requires(kIsBig<T> && std::is_same_v<AllocFor<T>, Alloc_> && kIsDefaultManager) {
+        checkCastIfEnabled<dynamicMM<T>>();
+        auto* t = *static_cast<T**>(ptr());
+        mmAndTag = 0;
+        return t;
+    }
+
+    // Available if the MemManager has the hash op. An empty Woid hashes to 0.
+    size_t hash() const
+        requires requires(const Manager* m) { m->hash(nullptr); } {
+        return mmAndTag == 0 ? 0 : mm()->hash(ptr());
+    }
+
+    // Available if the MemManager has the equality op. Objects of different types are never equal,
+    // which is told by their MemManagers alone.
+    friend bool operator==(const Woid& a, const Woid& b)
+        requires requires(const Manager* m) { m->equal(nullptr, nullptr); } {
+        if (!isSameManager(a.mm(), b.mm()))
+            return false;
+        return a.mmAndTag == 0 || a.mm()->equal(a.ptr(), b.ptr());
+    }
+
+    // Relocates both objects through a temporary, that is at most three indirect calls, or none if
+    // both are trivially relocatable. The generic swap makes three moves, two indirect calls each.
+    void swap(Woid& other) noexcept(kNothrowMove) {
+        if (this == &other)
+            return;
+        if constexpr (!kNothrowMove) {
+            // Moves may throw, hence each of them must leave the operands valid. The swap as a whole
+            // is only basic, see `ExceptionGuarantee::STRONG_DOUBLE_BUFFER`.
+            Woid tmp{std::move(*this)};
+            *this = std::move(other);
+            other = std::move(tmp);
+        } else {
+            alignas(kAlignment) std::array<char, kSize> tmp;
+            relocate(mmAndTag, ptr(), tmp.data());
+            relocate(other.mmAndTag, other.ptr(), ptr());
+            relocate(mmAndTag, tmp.data(), other.ptr());
+            std::swap(mmAndTag, other.mmAndTag);
+        }
+    }
+
+    template <typename S>
+        requires std::derived_from<S, Woid>
+    friend void swap(S& a, S& b) noexcept(noexcept(a.swap(b))) {
+        a.swap(b);
+    }
+
+    // Batched `std::destroy_n`, `std::uninitialized_copy_n` and `std::uninitialized_move_n` for the
+    // arrays of `S`, a Woid or a storage derived from it. A single `BatchOps` call is made per run
+    // of objects of the same type. The guarantee is that of the std ones: if a copy or a move
+    // throws, the objects made are destroyed and the exception is rethrown.
+    template <typename S>
+    static void destroyN(S* first, size_t n) {
+        forEachRun(first, n, [&](size_t i, size_t len) {
+            Woid& w = first[i];
+            if (w.mmAndTag != 0 && !(w.mmAndTag & kNoDestroyBit))
+                w.mm()->delN(w.ptr(), len, sizeof(S));
+        });
+    }
+
+    // A run is made empty and only tagged once copied, the batched copy undoing itself on a throw.
+    template <typename S>
+    static void uninitializedCopyN(const S* src, size_t n, S* dst)
+        requires(!kIsMoveOnly) {
+        size_t made = 0;
+        auto copyRuns = [&] {
+            forEachRun(src, n, [&](size_t i, size_t len) {
+                const Woid& from = src[i];
+                for (; made < i + len; made++)
+                    new (&dst[made]) S(Raw{}, 0);
+                if (from.mmAndTag != 0) {
+                    Woid& to = dst[i];
+                    from.mm()->cpyN(const_cast<void*>(from.ptr()),
+                                    to.ptrAt(from.mmAndTag),
+                                    len,
+                                    sizeof(S));
+                }
+                for (size_t k = i; k < i + len; k++)
+                    static_cast<Woid&>(dst[k]).mmAndTag = from.mmAndTag;
+            });
+        };
+#if defined(__cpp_exceptions)
+        try {
+            copyRuns();
+        } catch (...) {
+            std::destroy_n(dst, made);
+            throw;
+        }
+#else
+        copyRuns();
+#endif
+    }
+
+    // Moves that may throw are made one at a time, leaving the moved-from objects empty. Otherwise,
+    // as for the move constructor, a throw terminates.
+    template <typename S>
+    static void uninitializedMoveN(S* src, size_t n, S* dst) noexcept(kNothrowMove) {
+        if constexpr (!kNothrowMove) {
+            std::uninitialized_move_n(src, n, dst);
+        } else {
+            forEachRun(src, n, [&](size_t i, size_t len) {
+                Woid& from = src[i];
+                for (size_t k = i; k < i + len; k++)
+                    new (&dst[k]) S(Raw{}, from.mmAndTag);
+                if (from.mmAndTag != 0) {
+                    Woid& to = dst[i];
+                    from.mm()->moveN(from.ptr(), to.ptr(), len, sizeof(S));
+                }
+                for (size_t k = i; k < i + len; k++)
+                    static_cast<Woid&>(src[k]).mmAndTag = 0;
+            });
+        }
+    }
+
+    template <typename T, typename Self>
+    T get(this Self&& self) {
+        using TnoCvRef = std::remove_cvref_t<T>;
+
+        auto p = const_cast<void*>(std::forward<Self>(self).ptr());
+        if constexpr (kIsBig<TnoCvRef>) {
+            std::forward<Self>(self).template checkCastIfEnabled<dynamicMM<TnoCvRef>>();
+            p = *static_cast<void**>(p);
+        } else {
+            std::forward<Self>(self).template checkCastIfEnabled<staticMM<TnoCvRef>>();
+        }
+        return star<T, Self>(p);
+    }
+
+    // A pointer to the object if it is a `T`, null otherwise, whatever `SafeAnyCast` is. As the
+    // MemManager address is matched, the same caveat about the symbol visibility applies.
+    template <typename T, typename Self>
+    RetainConstPtr<Self, T> tryGet(this Self& self)
+        requires(kIsDefaultManager) {
+        if (!isSameManager(self.mm(), &kMemManagerFor<T>))
+            return nullptr;
+        return static_cast<RetainConstPtr<Self, T>>(objectAt<T>(const_cast<void*>(self.ptr())));
+    }
+
+    // Calls `f` with the object, forwarded like `Self`, if it is one of `Ts`. Otherwise calls `f()`
+    // if it can be called so, or reports a `BadAnyCast`. The MemManager is looked up in a table
+    // without branching, and each entry knows where its `T` lives, so a single indirect call is
+    // made.
+    template <typename... Ts, typename Self, typename F>
+    decltype(auto) visit(this Self&& self, F&& f)
+        requires(kIsDefaultManager && sizeof...(Ts) > 0) {
+        using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+        using R = std::invoke_result_t<F, ForwardedLike<Self, First>>;
+        static_assert((std::is_same_v<R, std::invoke_result_t<F, ForwardedLike<Self, Ts>>> && ...),
+                      "All the overloads must return the same type.");
+
+        static constexpr std::array<const MemManager*, sizeof...(Ts)> kManagers{
+            &kMemManagerFor<Ts>...};
+        static constexpr std::array<R (*)(void*, F&&), sizeof...(Ts) + 1> kCalls{
+            &visitOne<R, Self, F, Ts>..., &visitNone<R, F>};
+
+        const Manager* manager = self.mm();
+        size_t index = sizeof...(Ts);
+        for (size_t i = 0; i < sizeof...(Ts); i++)
+            index = isSameManager(kManagers[i], manager) ? i : index;
+        return kCalls[index](const_cast<void*>(self.ptr()), std::forward<F>(f));
+    }
+
+  private:
+    template <auto& MM, typename Self>
+    void checkCastIfEnabled(this Self&& self) {
+        if constexpr (kSafeAnyCast != SafeAnyCast::DISABLED) {
+            if (!isSameManager(std::forward<Self>(self).mm(), &MM)) {
+                reportBadAnyCast();
+            }
+        }
+    }
+
+    // Whether the MemManagers handle the same type. With TYPE_NAME, when the addresses differ, the
+    // hashes of the type names are compared too.
+    static bool isSameManager(const Manager* a, const Manager* b) {
+        if (a == b) [[likely]]
+            return true;
+        if constexpr (kSafeAnyCast == SafeAnyCast::TYPE_NAME) {
+            return a != nullptr && b != nullptr && a->typeNameHash == b->typeNameHash;
+        } else {
+            return false;
+        }
+    }
+
+    // The object is to be made by a batched op.
+    struct Raw {};
+    Woid(Raw, std::uintptr_t mmAndTag) : mmAndTag{mmAndTag} {}
+
+    template <typename S, typename F>
+    static void forEachRun(S* first, size_t n, F f) {
+        for (size_t i = 0; i < n;) {
+            const auto tag = static_cast<const Woid&>(first[i]).mmAndTag;
+            size_t j = i + 1;
+            while (j < n && static_cast<const Woid&>(first[j]).mmAndTag == tag)
+                j++;
+            f(i, j - i);
+            i = j;
+        }
+    }
+
+    const Manager* mm() const { return std::bit_cast<const Manager*>(mmAndTag & ~kTagBits); }
+
+    template <typename R, typename Self, typename F, typename T>
+    static R visitOne(void* p, F&& f) {
+        return std::invoke(std::forward<F>(f),
+                           std::forward_like<Self>(*static_cast<T*>(objectAt<T>(p))));
+    }
+
+    template <typename R, typename F>
+    static R visitNone(void*, F&& f) {
+        if constexpr (std::is_invocable_v<F>) {
+            return std::invoke(std::forward<F>(f));
+        } else {
+            reportBadAnyCast();
+            std::unreachable();
+        }
+    }
+
+    // The address of the `T` held in the buffer at `p`.
+    template <typename T>
+    static void* objectAt(void* p) {
+        if constexpr (kIsBig<T>) {
+            return *static_cast<void**>(p);
+        } else {
+            return p;
+        }
+    }
+
+    template <typename T, typename... Args>
+    T& construct(void* where, Args&&... args) {
+        if constexpr (kIsBig<T>) {
+            auto* obj = AllocFor<T>::template make<T>(std::forward<Args>(args)...);
+            *static_cast<void**>(where) = obj;
+            return *obj;
+        } else {
+            return *new (where) T(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename T>
+    T& object() {
+        if constexpr (kIsBig<T>) {
+            return **static_cast<T**>(ptr());
         } else {
-            if (this == &other)
-                return *this;
-            if (mm != nullptr)
-                mm->del(ptr());
-            if constexpr (kEg == ExceptionGuarantee::BASIC)
-                mm = nullptr;
-            other.mm->cpy(const_cast<void*>(other.ptr()), ptr());
-            mm = other.mm;
+            return *std::launder(static_cast<T*>(ptr()));
         }
-        return *this;
-    }
-    Woid(Woid&& other) noexcept(kEg != ExceptionGuarantee::BASIC) : mm(other.mm) {
-        mm->move(other.ptr(), ptr());
-        other.mm = nullptr;
-    }
-    Woid& operator=(Woid&& other) noexcept(kEg != ExceptionGuarantee::BASIC) {
-        if (this == &other)
-            return *this;
-        if (mm != nullptr)
-            mm->del(ptr());
-        if constexpr (kEg == ExceptionGuarantee::BASIC)
-            mm = nullptr;
-        other.mm->move(other.ptr(), ptr());
-        mm = other.mm;
-        other.mm = nullptr;
-        return *this;
     }
-    ~Woid() {
-        if (mm != nullptr)
-            mm->del(ptr());
+
+    void destroy() {
+        if (mmAndTag != 0 && !(mmAndTag & kNoDestroyBit))
+            mm()->del(ptr());
     }
 
-    template <typename T, typename Self>
-    T get(this Self&& self) {
-        using TnoCvRef = std::remove_cvref_t<T>;
+    static bool isTriviallyCopyable(std::uintptr_t tag) {
+        return (tag & (kRelocateBit | kNoDestroyBit)) == (kRelocateBit | kNoDestroyBit);
+    }
 
-        auto p = const_cast<void*>(std::forward<Self>(self).ptr());
-        if constexpr (kIsBig<TnoCvRef>) {
-            std::forward<Self>(self).template checkCastIfEnabled<dynamicMM<TnoCvRef>>();
-            p = *static_cast<void**>(p);
-        } else {
-            std::forward<Self>(self).template checkCastIfEnabled<staticMM<TnoCvRef>>();
+    static void copy(std::uintptr_t tag, const void* src, void* dst) {
+        if (isTriviallyCopyable(tag)) {
+            std::memcpy(dst, src, kSize);
+        } else if (tag != 0) {
+            std::bit_cast<const Manager*>(tag & ~kTagBits)->cpy(const_cast<void*>(src), dst);
         }
-        return star<T, Self>(p);
     }
 
-  private:
-    template <auto& MM, typename Self>
-    void checkCastIfEnabled(this Self&& self) {
-        if constexpr (kSafeAnyCast == SafeAnyCast::ENABLED) {
-            if (std::forward<Self>(self).mm != &MM) {
-                reportBadAnyCast();
-            }
+    static void relocate(std::uintptr_t tag, void* src, void* dst) {
+        if (tag & kRelocateBit) {
+            std::memcpy(dst, src, kSize);
+        } else if (tag != 0) {
+            std::bit_cast<const Manager*>(tag & ~kTagBits)->move(src, dst);
         }
     }
 
-    alignas(kAlignment) std::array<char, kSize> storage;
-    const MemManager* mm;
+    // Makes the object tagged `tag` in the spare half of the buffer, then destroys the current one.
+    // If making it throws, nothing has changed.
+    template <typename Make>
+    void replace(std::uintptr_t tag, Make make) {
+        const std::uintptr_t spare
+            = tag == 0 ? 0 : (tag & ~kSecondHalfBit) | (~mmAndTag & kSecondHalfBit);
+        make(ptrAt(spare));
+        destroy();
+        mmAndTag = spare;
+    }
+
+    // Moves the object of `other` here, leaving it empty. `mmAndTag` is `other`'s afterwards.
+    void relocateFrom(Woid& other) {
+        relocate(other.mmAndTag, other.ptr(), ptrAt(other.mmAndTag));
+        mmAndTag = other.mmAndTag;
+        other.mmAndTag = 0;
+    }
+
+    alignas(kAlignment) std::array<char, kDoubleBuffer ? 2 * kSize : kSize> storage;
+    std::uintptr_t mmAndTag;
 
     template <typename Self>
     decltype(auto) ptr(this Self&& self) {
-        return detail::ptr<Self>(std::forward<Self>(self).storage);
+        return std::forward<Self>(self).ptrAt(self.mmAndTag);
+    }
+
+    template <typename Self>
+    decltype(auto) ptrAt(this Self&& self, std::uintptr_t tag) {
+        const size_t offset = (tag & kSecondHalfBit) ? kSize : 0;
+        return static_cast<RetainConstPtr<Self, void>>(
+            std::launder(&std::forward<Self>(self).storage[offset]));
     }
 };
 
@@ -403,10 +1284,10 @@ struct Deleter {
     using Ptr = void (*)(void*);
     Ptr ptr;
 
-    constexpr Deleter() : ptr(nullptr) {}
     explicit Deleter(Ptr p) : ptr(p) {}
 
   public:
+    constexpr Deleter() : ptr(nullptr) {}
     template <typename T>
     explicit Deleter(TypeTag<T>) : ptr{+[](void* p) -> void { Alloc::del(static_cast<T*>(p)); }} {}
 
@@ -417,25 +1298,63 @@ struct Deleter {
 template <typename Alloc>
 struct DeleterCopier {
   protected:
-    using Ptr = void* (*)(Op, void*);
+    using Ptr = void* (*)(Op, void*, void*);
     Ptr ptr;
 
   public:
+    constexpr DeleterCopier() : ptr(nullptr) {}
     template <typename T>
     explicit DeleterCopier(TypeTag<T>)
-          : ptr{+[](Op op, void* p) -> void* {
+          : ptr{+[](Op op, void* p, void* dst) -> void* {
                 switch (op) {
                     case Op::DEL:
                         Alloc::del(static_cast<T*>(p));
                         return nullptr;
                     default:
+                        if constexpr (std::is_nothrow_copy_assignable_v<T>) {
+                            if (dst) {
+                                *static_cast<T*>(dst) = *static_cast<const T*>(p);
+                                return dst;
+                            }
+                        }
                         return Alloc::template make<T>(*static_cast<const T*>(p));
                 }
             }} {}
 
-    void del(void* p) const { ptr(Op::DEL, p); }
+    void del(void* p) const { ptr(Op::DEL, p, nullptr); }
     void operator()(void* p) const { del(p); }
-    void* cpy(void* p) const { return this->ptr(Op::CPY, p); }
+    void* cpy(void* p) const { return this->ptr(Op::CPY, p, nullptr); }
+
+    // Assigns to `dst`, an object of the same type, if that can't throw halfway. Otherwise copies
+    // to a new block like `cpy`.
+    void* cpyInto(void* p, void* dst) const { return this->ptr(Op::CPY, p, dst); }
+
+    bool operator==(const DeleterCopier&) const = default;
+};
+
+template <Copy kCopy>
+struct BoxMemManager {
+  protected:
+    using Ptr = void* (*)(Op, void*);
+
+  public:
+    void del(void* blk) const { ptr(Op::DEL, blk); }
+    void* cpy(void* blk) const
+        requires(kCopy == Copy::ENABLED) {
+        return ptr(Op::CPY, blk);
+    }
+
+    Ptr ptr;
+};
+
+// The header is the bare MemManager, so that the block doesn't depend on the Manager of the `Box`.
+template <typename MM, typename T>
+struct BoxBlk {
+    const MM* mm;
+    T t;
+    template <typename... Args>
+    BoxBlk(const MM* mm, std::in_place_t, Args&&... args)
+          : mm{mm}, t{std::forward<Args>(args)...} {}
 };
 
 template <Copy C, FunPtr F>
@@ -443,26 +1362,41 @@ struct MemManagerSelector;
 
 template <>
 struct MemManagerSelector<Copy::DISABLED, FunPtr::COMBINED> {
-    static constexpr auto Static = detail::mkMemManagerOnePtrStatic;
-    static constexpr auto Dynamic = detail::mkMemManagerOnePtrDynamic;
+    static constexpr auto Static = withOpsStatic<mkMemManagerOnePtrStatic, Copy::DISABLED>;
+    static constexpr auto Dynamic = withOpsDynamic<mkMemManagerOnePtrDynamic, Copy::DISABLED>;
 };
 
 template <>
 struct MemManagerSelector<Copy::DISABLED, FunPtr::DEDICATED> {
-    static constexpr auto Static = detail::mkMemManagerTwoPtrsStatic;
-    static constexpr auto Dynamic = detail::mkMemManagerTwoPtrsDynamic;
+    static constexpr auto Static = withOpsStatic<mkMemManagerTwoPtrsStatic, Copy::DISABLED>;
+    static constexpr auto Dynamic = withOpsDynamic<mkMemManagerTwoPtrsDynamic, Copy::DISABLED>;
 };
 
 template <>
 struct MemManagerSelector<Copy::ENABLED, FunPtr::COMBINED> {
-    static constexpr auto Static = detail::mkMemManagerOnePtrCpyStatic;
-    static constexpr auto Dynamic = detail::mkMemManagerOnePtrCpyDynamic;
+    static constexpr auto Static = withOpsStatic<mkMemManagerOnePtrCpyStatic, Copy::ENABLED>;
+    static constexpr auto Dynamic = withOpsDynamic<mkMemManagerOnePtrCpyDynamic, Copy::ENABLED>;
 };
 
 template <>
 struct MemManagerSelector<Copy::ENABLED, FunPtr::DEDICATED> {
-    static constexpr auto Static = detail::mkMemManagerThreePtrsStatic;
-    static constexpr auto Dynamic = detail::mkMemManagerThreePtrsDynamic;
+    static constexpr auto Static = withOpsStatic<mkMemManagerThreePtrsStatic, Copy::ENABLED>;
+    static constexpr auto Dynamic = withOpsDynamic<mkMemManagerThreePtrsDynamic, Copy::ENABLED>;
+};
+
+// Only the objects held inline share the functions: a heap block must be freed as its own type.
+template <Copy C, FunPtr F, Hash H, Equality E, Thunks kThunks>
+struct AnyMemManagerSelector {
+    static constexpr auto Static = withKeyOps<withThunks<MemManagerSelector<C, F>::Static, kThunks>,
+                                              H,
+                                              E,
+                                              mkHashOpStatic,
+                                              mkEqualOpStatic>;
+    static constexpr auto Dynamic = withKeyOps<MemManagerSelector<C, F>::Dynamic,
+                                               H,
+                                               E,
+                                               mkHashOpDynamic,
+                                               mkEqualOpDynamic>;
 };
 
 template <size_t Size>
@@ -504,6 +1438,18 @@ struct OneChunkAllocator {
     inline static Arena arena{};
 };
 
+// Set by woid_cpu_dispatch.hpp for the `CpuDispatch`es, which pick the function pointer of a `Fun`.
+template <typename T>
+constexpr inline bool kIsCpuDispatch = false;
+
+// Whether the trampoline of a `Fun` calls a value-initialized `F`. Such an `F` isn't stored at all,
+// the storage being left empty if it can be. So are `std::less<>` and the capture-less lambdas, but
+// not the function pointers, whose value is their state.
+template <typename F>
+constexpr inline bool kIsStateless = std::is_empty_v<F>
+                                     && std::is_trivially_default_constructible_v<F>
+                                     && std::is_trivially_copyable_v<F>;
+
 template <typename Storage_, typename R, typename... Args>
 class FunBase {
   protected:
@@ -513,14 +1459,29 @@ class FunBase {
   public:
     using Storage = Storage_;
     template <typename F>
-    explicit FunBase(F&&)
-        requires(!std::is_same_v<std::remove_cvref_t<F>, FunBase>)
+    constexpr explicit FunBase(F&&)
+        requires(!std::is_same_v<std::remove_cvref_t<F>, FunBase>
+                 && !kIsCpuDispatch<std::remove_cvref_t<F>>)
           : funPtr{+[](Storage& storage, Args... args) {
                 using FnoCv = std::remove_cvref_t<F>;
                 static constexpr bool IsConst = std::is_const_v<Storage>;
                 using FRef = std::conditional_t<IsConst, const FnoCv&, FnoCv&>;
-                return std::invoke(any_cast<FRef>(storage), std::forward<Args>(args)...);
+                if constexpr (kIsStateless<FnoCv>) {
+                    std::conditional_t<IsConst, const FnoCv, FnoCv> f{};
+                    return std::invoke(f, std::forward<Args>(args)...);
+                } else {
+                    return std::invoke(any_cast<FRef>(storage), std::forward<Args>(args)...);
+                }
             }} {}
+
+    template <typename F>
+        requires(kIsCpuDispatch<std::remove_cvref_t<F>>)
+    explicit FunBase(F&& f)
+          : funPtr{f.template select<FunPtr>([]<auto Impl> {
+                return +[](Storage&, Args... args) -> R {
+                    return std::invoke(Impl, std::forward<Args>(args)...);
+                };
+            })} {}
 };
 
 template <bool IsNoexcept, typename Storage, typename R, typename... Args>
@@ -532,7 +1493,7 @@ class ConstFun : public FunBase<const Storage, R, Args...> {
     using FunBase<const Storage, R, Args...>::FunBase;
 
     template <typename Self>
-    decltype(auto) operator()(this const Self& self, Args... args) noexcept(IsNoexcept) {
+    constexpr decltype(auto) operator()(this const Self& self, Args... args) noexcept(IsNoexcept) {
         return std::invoke(
             static_cast<const ConstFun*>(&self)->funPtr, self.storage, std::forward<Args>(args)...);
     }
@@ -547,7 +1508,7 @@ class NonConstFun : public FunBase<Storage, R, Args...> {
     using FunBase<Storage, R, Args...>::FunBase;
 
     template <typename Self>
-    decltype(auto) operator()(this Self& self, Args... args) noexcept(IsNoexcept) {
+    constexpr decltype(auto) operator()(this Self& self, Args... args) noexcept(IsNoexcept) {
         return std::invoke(
             static_cast<NonConstFun*>(&self)->funPtr, self.storage, std::forward<Args>(args)...);
     }
@@ -582,25 +1543,25 @@ struct MonoFunRef;
 template <typename R, typename... Args>
 struct MonoFunRef<R(Args...) const> : MonoFun<CRef, R(Args...) const> {
     template <typename F>
-    explicit MonoFunRef(const F* f) : MonoFun<CRef, R(Args...) const>{*f} {}
+    constexpr explicit MonoFunRef(const F* f) : MonoFun<CRef, R(Args...) const>{*f} {}
 };
 
 template <typename R, typename... Args>
 struct MonoFunRef<R(Args...) const noexcept> : MonoFun<CRef, R(Args...) const noexcept> {
     template <typename F>
-    explicit MonoFunRef(const F* f) : MonoFun<CRef, R(Args...) const>{*f} {}
+    constexpr explicit MonoFunRef(const F* f) : MonoFun<CRef, R(Args...) const>{*f} {}
 };
 
 template <typename R, typename... Args>
 struct MonoFunRef<R(Args...)> : MonoFun<Ref, R(Args...)> {
     template <typename F>
-    explicit MonoFunRef(F* f) : MonoFun<Ref, R(Args...)>{*f} {}
+    constexpr explicit MonoFunRef(F* f) : MonoFun<Ref, R(Args...)>{*f} {}
 };
 
 template <typename R, typename... Args>
 struct MonoFunRef<R(Args...) noexcept> : MonoFun<Ref, R(Args...) noexcept> {
     template <typename F>
-    explicit MonoFunRef(F* f) : MonoFun<Ref, R(Args...)>{*f} {}
+    constexpr explicit MonoFunRef(F* f) : MonoFun<Ref, R(Args...)>{*f} {}
 };
 
 class FixedString {
@@ -637,14 +1598,14 @@ struct RefImpl {
 
     struct ConversionTag {};
 
-    RefImpl(ConversionTag, Obj obj) : obj(obj) {}
+    constexpr RefImpl(ConversionTag, Obj obj) : obj(obj) {}
 
   public:
     template <typename T>
-        requires(Const || !std::is_const_v<T>) explicit RefImpl(T& t) : obj{&t} {}
+        requires(Const || !std::is_const_v<T>) constexpr explicit RefImpl(T& t) : obj{&t} {}
 
     template <typename T, typename Self>
-    T get(this Self&& self) {
+    constexpr T get(this Self&& self) {
         using TnoRef = std::remove_cvref_t<T>;
         using TP = std::conditional_t<Const, const TnoRef*, TnoRef*>;
         return static_cast<T>(*static_cast<TP>(self.obj));
@@ -680,16 +1641,138 @@ struct Overload : OverloadImpl<M, ValueTag<M::Name>, ConstTag<M::IsConst>, typen
 template <FixedString Name, bool IsConst, typename ArgList, typename... Ms>
 struct FindBest;
 
-template <FixedString Name, bool IsConst, typename... Args, typename... Ms>
-struct FindBest<Name, IsConst, Typelist<Args...>, Ms...> : Overload<Ms>... {
+template <typename... Ms>
+struct Probes : Overload<Ms>... {
     using Overload<Ms>::probe...;
+};
 
-    using type = decltype(probe(ValueTag<Name>{}, ConstTag<IsConst>{}, std::declval<Args>()...));
+template <FixedString Name, bool IsConst, typename... Args, typename... Ms>
+struct FindBest<Name, IsConst, Typelist<Args...>, Ms...> {
+    using type = decltype(Probes<Ms...>::probe(
+        ValueTag<Name>{}, ConstTag<IsConst>{}, std::declval<Args>()...));
 };
 
 template <FixedString Name, bool IsConst, typename ArgList, typename... Ms>
 using FindBestT = FindBest<Name, IsConst, ArgList, Ms...>::type;
 
+template <FixedString Name, bool IsConst, typename ArgList, typename... Ms>
+constexpr inline bool kCanFind = false;
+
+template <FixedString Name, bool IsConst, typename... Args, typename... Ms>
+constexpr inline bool kCanFind<Name, IsConst, Typelist<Args...>, Ms...> = requires {
+    Probes<Ms...>::probe(ValueTag<Name>{}, ConstTag<IsConst>{}, std::declval<Args>()...);
+};
+
+// Dispatches on a runtime method name. The distinct names of Ms are perfectly hashed at compile
+// time: `slot` is injective on them, so a lookup is a single probe. Every call signature gets its
+// own table of trampolines, with a null entry for the names it can't call.
+template <typename... Ms>
+struct ByName {
+  private:
+    static constexpr std::array<FixedString, sizeof...(Ms)> kAll{Ms::Name...};
+
+    static constexpr bool isFirst(size_t i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (kAll[j] == kAll[i])
+                return false;
+        }
+        return true;
+    }
+
+    static constexpr size_t countDistinct() {
+        size_t n = 0;
+        for (size_t i = 0; i < kAll.size(); ++i) {
+            n += isFirst(i);
+        }
+        return n;
+    }
+
+    static constexpr size_t kCount = countDistinct();
+
+    static constexpr auto kDistinct = [] {
+        std::array<size_t, kCount> distinct{};
+        size_t n = 0;
+        for (size_t i = 0; i < kAll.size(); ++i) {
+            if (isFirst(i))
+                distinct[n++] = i;
+        }
+        return distinct;
+    }();
+
+    static constexpr std::string_view name(size_t i) {
+        return static_cast<const char*>(kAll[kDistinct[i]]);
+    }
+
+    static constexpr size_t slot(std::uint64_t hash, std::uint64_t seed, unsigned bits) {
+        return static_cast<size_t>(((hash ^ seed) * 0x9e3779b97f4a7c15) >> (64 - bits));
+    }
+
+    struct Params {
+        unsigned bits;
+        std::uint64_t seed;
+    };
+
+    static constexpr Params findParams() {
+        for (unsigned bits = std::max(1u, static_cast<unsigned>(std::bit_width(kCount)));; ++bits) {
+            for (std::uint64_t seed = 0; seed < 1024; ++seed) {
+                bool isPerfect = true;
+                for (size_t i = 0; i < kCount && isPerfect; ++i) {
+                    for (size_t j = 0; j < i && isPerfect; ++j) {
+                        isPerfect = slot(fnv1a(name(i)), seed, bits)
+                                    != slot(fnv1a(name(j)), seed, bits);
+                    }
+                }
+                if (isPerfect)
+                    return {bits, seed};
+            }
+        }
+    }
+
+    static constexpr Params kParams = findParams();
+
+    template <typename R, typename I, FixedString Name, typename... Args>
+    static consteval auto trampoline() -> R (*)(I&, Args&&...) {
+        if constexpr (kCanFind<Name, IsConstRef<I>, Typelist<Args&&...>, Ms...>) {
+            using Ret = decltype(std::declval<I&>().template call<Name>(std::declval<Args>()...));
+            if constexpr (std::is_void_v<R> || std::is_convertible_v<Ret, R>) {
+                return +[](I& i, Args&&... args) -> R {
+                    return static_cast<R>(i.template call<Name>(std::forward<Args>(args)...));
+                };
+            }
+        }
+        return nullptr;
+    }
+
+  public:
+    template <typename R, typename I, typename... Args>
+    static R call(I& i, std::string_view methodName, Args&&... args) {
+        struct Entry {
+            std::uint64_t hash = 0;
+            std::string_view name{};
+            R (*fn)(I&, Args&&...) = nullptr;
+        };
+
+        static constexpr auto kTable = []<size_t... Is>(std::index_sequence<Is...>) {
+            std::array<Entry, size_t{1} << kParams.bits> table{};
+            ((table[slot(fnv1a(name(Is)), kParams.seed, kParams.bits)]
+              = Entry{fnv1a(name(Is)),
+                      name(Is),
+                      trampoline<R, I, kAll[kDistinct[Is]], Args...>()}),
+             ...);
+            return table;
+        }(std::make_index_sequence<kCount>{});
+
+        const auto hash = fnv1a(methodName);
+        const auto& entry = kTable[slot(hash, kParams.seed, kParams.bits)];
+        // The hash tells the names apart unless they collide in all 64 bits, the comparison is
+        // there for the sake of correctness and is only reached on a hit.
+        if (entry.fn == nullptr || entry.hash != hash || entry.name != methodName) {
+            reportUnknownMethod();
+        }
+        return entry.fn(i, std::forward<Args>(args)...);
+    }
+};
+
 template <typename T, bool IsConst>
 using ConditionalRef = std::conditional_t<IsConst, const T&, T&>;
 
@@ -712,9 +1795,10 @@ class MethodImpl {
     constexpr static inline auto Name = Name_;
     constexpr static inline auto IsConst = IsConst_;
     using Args = Typelist<Args_...>;
+    using Return = R;
 
     template <typename T>
-    MethodImpl(detail::TypeTag<T>)
+    constexpr MethodImpl(detail::TypeTag<T>)
           : funPtr{+[](detail::ConditionalRef<S, IsConst_> s, Args_... args) -> R {
                 static constexpr auto m = MethodLam.template operator()<T>();
                 return std::invoke(m,
@@ -722,17 +1806,121 @@ class MethodImpl {
                                    std::forward<Args_>(args)...);
             }} {}
 
-    decltype(auto) invoke(S& s, Args_... args)
+    constexpr decltype(auto) invoke(S& s, Args_... args) const
         requires(!IsConst_) {
         return std::invoke(funPtr, s, std::forward<Args_&&>(args)...);
     }
 
-    decltype(auto) invoke(const S& s, Args_... args) const
+    constexpr decltype(auto) invoke(const S& s, Args_... args) const
         requires(IsConst_) {
         return std::invoke(funPtr, s, std::forward<Args_&&>(args)...);
     }
 };
 
+template <typename M>
+constexpr inline bool kIsCached = requires { M::kIsCached; };
+
+// The views don't own the object, which may hence change behind the back of a cache.
+template <typename Storage>
+constexpr inline bool kIsView = std::is_same_v<Storage, Ref> || std::is_same_v<Storage, CRef>;
+
+// A pure method of no arguments whose result the Interface memoizes, see `Caches`.
+template <typename M>
+struct CachedMethod : M {
+    static_assert(M::IsConst && std::is_same_v<typename M::Args, Typelist<>>);
+    static_assert(!std::is_void_v<typename M::Return> && !std::is_reference_v<typename M::Return>);
+
+    template <typename S_>
+    using WithStorage = CachedMethod<typename M::template WithStorage<S_>>;
+
+    static constexpr inline bool kIsCached = true;
+
+    template <typename T>
+    constexpr CachedMethod(TypeTag<T> tag) : M{tag} {}
+};
+
+template <typename M>
+struct CacheSlot {};
+
+template <typename M>
+    requires(kIsCached<M>)
+struct CacheSlot<M> {
+    std::optional<typename M::Return> value;
+};
+
+// A slot per cached method, empty if there are none. A non-const method may change the object,
+// hence it invalidates all of them.
+template <typename... Ms>
+struct Caches : CacheSlot<Ms>... {
+    template <typename M, typename S, typename... Args>
+    constexpr decltype(auto) invoke(const M* method, S& s, Args&&... args) {
+        if constexpr (kIsCached<M>) {
+            auto& value = static_cast<CacheSlot<M>&>(*this).value;
+            if (!value) {
+                value.emplace(method->invoke(s));
+            }
+            return typename M::Return{*value};
+        } else {
+            if constexpr (!M::IsConst) {
+                invalidate();
+            }
+            return method->invoke(s, std::forward<Args>(args)...);
+        }
+    }
+
+    constexpr void invalidate() { (reset<Ms>(), ...); }
+
+  private:
+    template <typename M>
+    constexpr void reset() {
+        if constexpr (kIsCached<M>) {
+            static_cast<CacheSlot<M>&>(*this).value.reset();
+        }
+    }
+};
+
+// Marks the binary methods in the overload set, hence `call` never picks them.
+struct BinaryTag {};
+
+// A const method of two operands of the same interface. If both hold the same type (i.e. their
+// `kTypeId`s match) the single per-type thunk handles them. Otherwise `CrossLam` gets both
+// interfaces. The thunks themselves are no proof of the type, as identical ones may be folded.
+template <FixedString Name_, auto SameLam, auto CrossLam, typename S, typename R>
+class BinaryMethodImpl {
+  protected:
+    using Ptr = R (*)(const S&, const S&);
+
+    Ptr funPtr;
+    const void* type;
+
+  public:
+    template <typename S_>
+    using WithStorage = BinaryMethodImpl<Name_, SameLam, CrossLam, S_, R>;
+
+    constexpr static inline auto Name = Name_;
+    constexpr static inline auto IsConst = true;
+    using Args = Typelist<BinaryTag>;
+
+    template <typename T>
+    constexpr BinaryMethodImpl(detail::TypeTag<T>)
+          : funPtr{+[](const S& s, const S& other) -> R {
+                return std::invoke(SameLam, any_cast<const T&>(s), any_cast<const T&>(other));
+            }},
+            type{&detail::kTypeId<T>} {}
+
+    template <typename I>
+    R invoke(const S& s,
+             const S& otherS,
+             const BinaryMethodImpl& other,
+             const I& i,
+             const I& otherI) const {
+        if (type == other.type) {
+            return std::invoke(funPtr, s, otherS);
+        }
+        return std::invoke(CrossLam, i, otherI);
+    }
+};
+
 template <FixedString Name_, auto L, typename V, typename F>
 struct SealedMethod;
 
@@ -742,7 +1930,7 @@ struct SealedMethod<Name_, L, V, R(Args_...)> {
     constexpr static inline auto IsConst = false;
     using Args = Typelist<Args_...>;
 
-    decltype(auto) invoke(V& v, Args_... args) {
+    constexpr decltype(auto) invoke(V& v, Args_... args) const {
         return visit(
             [&args...](auto& obj) { return std::invoke(L, obj, std::forward<Args_>(args)...); }, v);
     }
@@ -755,7 +1943,7 @@ struct SealedMethod<Name_, L, V, R(Args_...) const> {
     constexpr static inline auto IsConst = true;
     using Args = Typelist<Args_...>;
 
-    decltype(auto) invoke(const V& v, Args_... args) const {
+    constexpr decltype(auto) invoke(const V& v, Args_... args) const {
         return visit(
             [&args...](const auto& obj) {
                 return std::invoke(L, obj, std::forward<Args_>(args)...);
@@ -767,15 +1955,20 @@ struct SealedMethod<Name_, L, V, R(Args_...) const> {
 template <typename Storage, typename... Ms>
 struct VTable : Ms... {
     template <typename T>
-    VTable(TypeTag<T>) : Ms{detail::TypeTag<std::remove_cvref_t<T>>{}}... {}
+    constexpr VTable(TypeTag<T>) : Ms{detail::TypeTag<std::remove_cvref_t<T>>{}}... {}
 
-    VTable() : Ms{}... {}
+    constexpr VTable() : Ms{}... {}
+
+    // The constness of the lookup is that of the interface, not of the table: a shared table is
+    // always const, yet it has to serve the non-const methods too.
+    template <FixedString Name, bool IsConst, typename... Args>
+    constexpr auto* findMethod() const {
+        return static_cast<const FindBestT<Name, IsConst, Typelist<Args...>, Ms...>*>(this);
+    }
 
     template <FixedString Name, typename... Args, typename Self>
     constexpr auto* getMethod(this Self&& self) {
-        constexpr bool IsConst = IsConstRef<Self>;
-        using Result = RetainConstPtr<Self, FindBestT<Name, IsConst, Typelist<Args...>, Ms...>>;
-        return static_cast<Result>(&self);
+        return self.template findMethod<Name, IsConstRef<Self>, Args...>();
     }
 };
 
@@ -784,24 +1977,42 @@ struct HasVTable {
   private:
     using Table = VTable<Storage, Ms...>;
 
+    // Constant-initialized, hence no dynamic initialization and the table ends up in .rodata.
     template <typename T>
-    static inline auto vTableStatic = Table{TypeTag<T>{}};
+    static constexpr inline Table vTableStatic = Table{TypeTag<T>{}};
 
-    Table* vTable;
+    const Table* vTable;
 
   public:
     template <typename T>
-    HasVTable(TypeTag<T>) {
-        vTable = &vTableStatic<T>;
-    }
+    constexpr HasVTable(TypeTag<T>) : vTable{&vTableStatic<T>} {}
 
     template <FixedString Name, typename... Args, typename Self>
     constexpr auto* getMethod(this Self&& self) {
-        return static_cast<RetainConstPtr<Self, Table>>(self.vTable)
-            ->template getMethod<Name, Args...>();
+        return self.vTable->template findMethod<Name, IsConstRef<Self>, Args...>();
     }
 };
 
+template <typename Storage, typename... Ms>
+struct UnifiedVTable;
+
+template <typename Storage, typename... Ms>
+using UnifiedStorage = Storage::template WithManager<UnifiedVTable<Storage, Ms...>>;
+
+// Both the MemManager of the storage and the methods. The storage points at it instead of at the
+// bare MemManager and the interface keeps no pointer of its own.
+template <typename Storage, typename... Ms>
+struct UnifiedVTable
+      : Storage::MemManager,
+        VTable<UnifiedStorage<Storage, Ms...>,
+               typename Ms::template WithStorage<UnifiedStorage<Storage, Ms...>>...> {
+    template <typename T>
+    constexpr UnifiedVTable(TypeTag<T> tag)
+          : Storage::MemManager{Storage::template kMemManagerFor<T>},
+            VTable<UnifiedStorage<Storage, Ms...>,
+                   typename Ms::template WithStorage<UnifiedStorage<Storage, Ms...>>...>{tag} {}
+};
+
 template <VTableOwnership O, typename Storage, typename... Ms>
 using HasOrIsVTable = std::
     conditional_t<O == VTableOwnership::SHARED, HasVTable<Storage, Ms...>, VTable<Storage, Ms...>>;
@@ -813,27 +2024,70 @@ template <size_t kSize = sizeof(void*),
           size_t kAlignment = alignof(void*),
           FunPtr kFunPtr = FunPtr::COMBINED,
           SafeAnyCast kSafeAnyCast = SafeAnyCast::DISABLED,
-          typename Alloc = DefaultAllocator>
-struct Any : public detail::Woid<detail::MemManagerSelector<kCopy, kFunPtr>::Static,
-                                 detail::MemManagerSelector<kCopy, kFunPtr>::Dynamic,
-                                 kSize,
-                                 kAlignment,
-                                 kEg,
-                                 kCopy,
-                                 kSafeAnyCast,
-                                 Alloc> {
-    using detail::Woid<detail::MemManagerSelector<kCopy, kFunPtr>::Static,
-                       detail::MemManagerSelector<kCopy, kFunPtr>::Dynamic,
-                       kSize,
-                       kAlignment,
-                       kEg,
-                       kCopy,
-                       kSafeAnyCast,
-                       Alloc>::Woid;
-};
+          typename Alloc = DefaultAllocator,
+          Hash kHash = Hash::DISABLED,
+          Equality kEquality = Equality::DISABLED,
+          Thunks kThunks = Thunks::PER_TYPE>
+struct Any
+      : public detail::Woid<
+            detail::AnyMemManagerSelector<kCopy, kFunPtr, kHash, kEquality, kThunks>::Static,
+            detail::AnyMemManagerSelector<kCopy, kFunPtr, kHash, kEquality, kThunks>::Dynamic,
+            kSize,
+            kAlignment,
+            kEg,
+            kCopy,
+            kSafeAnyCast,
+            Alloc> {
+    using detail::Woid<
+        detail::AnyMemManagerSelector<kCopy, kFunPtr, kHash, kEquality, kThunks>::Static,
+        detail::AnyMemManagerSelector<kCopy, kFunPtr, kHash, kEquality, kThunks>::Dynamic,
+        kSize,
+        kAlignment,
+        kEg,
+        kCopy,
+        kSafeAnyCast,
+        Alloc>::Woid;
+};
+
+// Batched lifecycle ops over arrays of `Any`, see `detail::Woid::destroyN`.
+template <typename S>
+void destroy_n(S* first, size_t n)
+    requires requires { S::destroyN(first, n); } {
+    S::destroyN(first, n);
+}
+
+template <typename S>
+void uninitialized_copy_n(const S* src, size_t n, S* dst)
+    requires requires { S::uninitializedCopyN(src, n, dst); } {
+    S::uninitializedCopyN(src, n, dst);
+}
+
+template <typename S>
+void uninitialized_move_n(S* src, size_t n, S* dst)
+    requires requires { S::uninitializedMoveN(src, n, dst); } {
+    S::uninitializedMoveN(src, n, dst);
+}
+
+namespace detail {
+// The storages and the interfaces, told apart from the foreign types by the constants they expose.
+template <typename T>
+concept IsStorageOrInterface
+    = std::same_as<std::remove_cv_t<decltype(T::kExceptionGuarantee)>, ExceptionGuarantee>
+      || std::same_as<std::remove_cv_t<decltype(T::kVTableOwnership)>, VTableOwnership>;
+} // namespace detail
+
+// Found by ADL for the iterators over the storages and interfaces, which all have a relocating
+// member `swap`. Not for those over the other types having woid template arguments, e.g. a
+// `std::pair<Any<>, int>`.
+template <std::indirectly_readable It>
+    requires detail::IsStorageOrInterface<std::iter_value_t<It>>
+             && requires(std::iter_reference_t<It> r) { r.swap(r); }
+void iter_swap(It a, It b) noexcept(noexcept((*a).swap(*b))) {
+    (*a).swap(*b);
+}
 
 template <typename T, typename Storage>
-decltype(auto) any_cast(Storage&& s) {
+constexpr decltype(auto) any_cast(Storage&& s) {
     constexpr static bool isConst = std::is_const_v<Storage>;
     constexpr static bool isRef = std::is_lvalue_reference_v<Storage> && !isConst;
     constexpr static bool isConstRef = std::is_lvalue_reference_v<Storage> && isConst;
@@ -845,6 +2099,35 @@ decltype(auto) any_cast(Storage&& s) {
     return std::forward<Storage>(s).template get<T>();
 }
 
+// Moves the `T` held by `from` into a new `To`. If `from` has it in a bare heap block (see
+// `release`) and `To` takes one from the same allocator, the block changes hands. Otherwise the
+// object is moved. The type isn't told by the storages, hence the caller has to name it.
+template <typename To, typename T, typename From>
+    requires(!std::is_lvalue_reference_v<From>)
+To convert(From&& from) {
+    if constexpr (std::is_same_v<typename To::Alloc, typename From::Alloc>
+                  && requires { To{kTransferOwnership, from.template release<T>()}; }) {
+        return To{kTransferOwnership, from.template release<T>()};
+    } else {
+        return To{std::in_place_type<T>, any_cast<T&&>(std::move(from))};
+    }
+}
+
+// A pointer to the object of `s` if it is a `T`, null otherwise. Never throws.
+template <typename T, typename Storage>
+auto try_cast(Storage& s) -> decltype(s.template tryGet<T>()) {
+    return s.template tryGet<T>();
+}
+
+// Calls the overload of `f` taking the object of `s`, which is one of `Ts`, see
+// `detail::Woid::visit`.
+template <typename... Ts, typename Storage, typename F>
+decltype(auto) visit(Storage&& s, F&& f)
+    requires(sizeof...(Ts) > 0
+             && requires { std::forward<Storage>(s).template visit<Ts...>(std::forward<F>(f)); }) {
+    return std::forward<Storage>(s).template visit<Ts...>(std::forward<F>(f));
+}
+
 template <Copy kCopy = Copy::ENABLED, typename Alloc_ = DefaultAllocator>
 class DynamicAny {
   private:
@@ -862,14 +2145,23 @@ class DynamicAny {
     inline static constexpr auto kSafeAnyCast = SafeAnyCast::DISABLED;
     using Alloc = Alloc_;
 
+    // Holds nothing, as if moved from.
     constexpr DynamicAny() : storage(nullptr) {}
 
     DynamicAny(const DynamicAny& other)
         requires(!kIsMoveOnly)
-          : storage{other.getDeleter().cpy(other.storage.get()), other.getDeleter()} {}
+          : storage{other.storage ? other.getDeleter().cpy(other.storage.get()) : nullptr,
+                    other.getDeleter()} {}
 
+    // The block is reused if it holds an object of the same type, see `DeleterCopier::cpyInto`.
     DynamicAny& operator=(const DynamicAny& other)
         requires(!kIsMoveOnly) {
+        if (storage && other.storage && getDeleter() == other.getDeleter()) {
+            void* copy = getDeleter().cpyInto(other.storage.get(), storage.get());
+            if (copy != storage.get())
+                storage.reset(copy);
+            return *this;
+        }
         *this = DynamicAny{other};
         return *this;
     }
@@ -877,29 +2169,188 @@ class DynamicAny {
     template <typename T, typename TnoRef = std::remove_cvref_t<T>>
         requires(!std::is_same_v<std::remove_cvref_t<T>, DynamicAny>) explicit DynamicAny(T&& t)
           : storage{Alloc::template make<TnoRef>(std::forward<T>(t)),
-                    MM{detail::kTypeTag<TnoRef>}} {}
+                    MM{detail::kTypeTag<TnoRef>}} {
+        detail::checkHeapOnlyPolicy<TnoRef, DynamicAny>();
+    }
 
     template <typename T>
     DynamicAny(TransferOwnership, T* t)
-          : storage{t, MM{detail::kTypeTag<std::remove_cvref_t<T>>}} {}
+          : storage{t, MM{detail::kTypeTag<std::remove_cvref_t<T>>}} {
+        detail::checkHeapOnlyPolicy<std::remove_cvref_t<T>, DynamicAny>();
+    }
 
     DynamicAny& operator=(DynamicAny&& t) noexcept {
         storage = std::move(t.storage);
         return *this;
     }
 
-    DynamicAny(DynamicAny&& t) : storage(std::move(t.storage)) {}
+    DynamicAny(DynamicAny&& t) : storage(std::move(t.storage)) {}
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        *this = DynamicAny{std::in_place_type<T>, std::forward<Args>(args)...};
+        return *static_cast<T*>(storage.get());
+    }
+
+    void reset() { storage.reset(); }
+
+    // Gives up the block holding the `T`, to be freed by `Alloc`.
+    template <typename T>
+    T* release() {
+        return static_cast<T*>(storage.release());
+    }
+
+    void swap(DynamicAny& other) noexcept { storage.swap(other.storage); }
+
+    template <typename S>
+        requires std::derived_from<S, DynamicAny>
+    friend void swap(S& a, S& b) noexcept {
+        a.swap(b);
+    }
+
+    template <typename T, typename... Args>
+    DynamicAny(std::in_place_type_t<T>, Args&&... args)
+          : storage{Alloc::template make<T>(std::forward<Args>(args)...), MM{detail::kTypeTag<T>}} {
+        detail::checkHeapOnlyPolicy<T, DynamicAny>();
+    }
+
+    ~DynamicAny() = default;
+
+    template <typename T, typename Self>
+    T get(this Self&& self) {
+        return detail::star<T, Self>(std::forward<Self>(self).storage.get());
+    }
+};
+
+// A single pointer to a heap block starting with a pointer to the MemManager, which is followed by
+// the object. With a unified vtable (see `VTableOwnership::UNIFIED`) the header is the vtable.
+template <Copy kCopy = Copy::ENABLED,
+          typename Alloc_ = DefaultAllocator,
+          typename Manager = detail::BoxMemManager<kCopy>>
+class Box {
+  public:
+    using MemManager = detail::BoxMemManager<kCopy>;
+
+  private:
+    static constexpr bool kIsMoveOnly = kCopy == Copy::DISABLED;
+    static constexpr bool kIsDefaultManager = std::is_same_v<Manager, MemManager>;
+
+    template <typename T>
+    using Blk = detail::BoxBlk<MemManager, T>;
+
+    void* blk;
+
+  public:
+    using Alloc = Alloc_;
+    inline static constexpr auto kExceptionGuarantee = ExceptionGuarantee::STRONG;
+    inline static constexpr auto kStaticStorageSize = 0;
+    inline static constexpr auto kStaticStorageAlignment = 0;
+    inline static constexpr auto kSafeAnyCast = SafeAnyCast::DISABLED;
+
+    template <typename T>
+    static constexpr inline MemManager kMemManagerFor{+[](detail::Op op, void* p) -> void* {
+        auto* b = static_cast<Blk<T>*>(p);
+        if constexpr (!kIsMoveOnly) {
+            if (op == detail::Op::CPY) {
+                return Alloc::template make<Blk<T>>(*b);
+            }
+        }
+        Alloc::del(b);
+        return nullptr;
+    }};
+
+    template <typename NewManager>
+    using WithManager = Box<kCopy, Alloc_, NewManager>;
+
+    // Holds nothing, as if moved from.
+    constexpr Box() : blk{nullptr} {}
+
+    template <typename T, typename TnoRef = std::remove_cvref_t<T>>
+        requires(!std::is_same_v<TnoRef, Box>)
+    explicit Box(T&& t) : Box{std::in_place_type<TnoRef>, std::forward<T>(t)} {}
+
+    template <typename T, typename... Args>
+    explicit Box(std::in_place_type_t<T> tag, Args&&... args)
+        requires(kIsDefaultManager)
+          : Box{&kMemManagerFor<T>, tag, std::forward<Args>(args)...} {}
+
+    template <typename T, typename... Args>
+    explicit Box(const Manager* manager, std::in_place_type_t<T>, Args&&... args) {
+        SUPPRESS_OFFSETOF_WARNING_START
+        // See the note in `detail::HeapStorage`.
+        static_assert(offsetof(Blk<T>, mm) == 0);
+        SUPPRESS_OFFSETOF_WARNING_END
+        detail::checkHeapOnlyPolicy<T, Box<kCopy, Alloc_>>();
+        blk = Alloc::template make<Blk<T>>(manager, std::in_place, std::forward<Args>(args)...);
+    }
+
+    // The object has to be preceded by the header, hence it's moved into a new block.
+    template <typename T>
+    Box(TransferOwnership, T* tPtr)
+        requires(!std::is_const_v<T> && kIsDefaultManager)
+          : Box{std::in_place_type<T>, std::move(*tPtr)} {
+        Alloc::del(tPtr);
+    }
+
+    Box(Box&& other) noexcept : blk(other.blk) { other.blk = nullptr; }
+    Box& operator=(Box&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        reset();
+        blk = other.blk;
+        other.blk = nullptr;
+        return *this;
+    }
+
+    void swap(Box& other) noexcept { std::swap(blk, other.blk); }
+
+    template <typename S>
+        requires std::derived_from<S, Box>
+    friend void swap(S& a, S& b) noexcept {
+        a.swap(b);
+    }
+
+    Box(const Box& other)
+        requires(!kIsMoveOnly)
+          : blk{other.blk ? other.getManager()->cpy(other.blk) : nullptr} {}
+    Box& operator=(const Box& other)
+        requires(!kIsMoveOnly) {
+        *this = Box{other};
+        return *this;
+    }
+
+    ~Box() { reset(); }
 
-    template <typename T, typename... Args>
-    DynamicAny(std::in_place_type_t<T>, Args&&... args)
-          : storage{Alloc::template make<T>(std::forward<Args>(args)...), MM{detail::kTypeTag<T>}} {
+    const Manager* getManager() const {
+        return static_cast<const Manager*>(*static_cast<const MemManager* const*>(blk));
     }
 
-    ~DynamicAny() = default;
-
     template <typename T, typename Self>
     T get(this Self&& self) {
-        return detail::star<T, Self>(std::forward<Self>(self).storage.get());
+        using TnoCvRef = std::remove_cvref_t<T>;
+        auto* b = static_cast<detail::RetainConstPtr<Self, Blk<TnoCvRef>>>(
+            std::forward<Self>(self).blk);
+        return std::forward_like<Self>(b->t);
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args)
+        requires(kIsDefaultManager) {
+        return emplace(&kMemManagerFor<T>, std::in_place_type<T>, std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(const Manager* manager, std::in_place_type_t<T> tag, Args&&... args) {
+        *this = Box{manager, tag, std::forward<Args>(args)...};
+        return get<T&>();
+    }
+
+    void reset() {
+        if (blk != nullptr) {
+            getManager()->del(blk);
+            blk = nullptr;
+        }
     }
 };
 
@@ -928,6 +2379,9 @@ struct HeapStorage {
     inline static constexpr auto kStaticStorageAlignment = 0;
     inline static constexpr auto kSafeAnyCast = SafeAnyCast::DISABLED;
 
+    // Holds nothing, as if moved from.
+    constexpr HeapStorage() : storage{nullptr} {}
+
     template <typename T, typename TnoRef = std::remove_cvref_t<T>>
         requires(!std::is_same_v<std::remove_cvref_t<T>, HeapStorage>)
     explicit HeapStorage(T&& t) : HeapStorage{std::in_place_type<TnoRef>, std::forward<T>(t)} {}
@@ -962,6 +2416,14 @@ struct HeapStorage {
         storage = Alloc::template make<Blk<T>>(ptr, std::forward<Args>(args)...);
     }
 
+    // The object has to be preceded by the header, hence it's moved into a new block.
+    template <typename T>
+    HeapStorage(TransferOwnership, T* tPtr)
+        requires(!std::is_const_v<T>)
+          : HeapStorage{std::in_place_type<T>, std::move(*tPtr)} {
+        Alloc::del(tPtr);
+    }
+
     HeapStorage(HeapStorage&& other) noexcept : storage(other.storage) { other.storage = nullptr; }
     HeapStorage& operator=(HeapStorage&& other) noexcept {
         if (this == &other) {
@@ -974,9 +2436,18 @@ struct HeapStorage {
         return *this;
     }
 
+    void swap(HeapStorage& other) noexcept { std::swap(storage, other.storage); }
+
+    template <typename S>
+        requires std::derived_from<S, HeapStorage>
+    friend void swap(S& a, S& b) noexcept {
+        a.swap(b);
+    }
+
     HeapStorage(const HeapStorage& other)
         requires(!kIsMoveOnly)
-          : storage{std::invoke(other.funPtr(), Op::CPY, other.storage)} {}
+          : storage{other.storage ? std::invoke(other.funPtr(), Op::CPY, other.storage) : nullptr} {
+    }
     HeapStorage& operator=(const HeapStorage& other)
         requires(!kIsMoveOnly) {
         *this = HeapStorage{other};
@@ -986,7 +2457,7 @@ struct HeapStorage {
 
     template <typename T, typename Self>
     T get(this Self&& self) {
-        using TnoRef = std::remove_reference_t<T>;
+        using TnoRef = std::remove_cvref_t<T>;
         auto* b
             = reinterpret_cast<RetainConstPtr<Self, Blk<TnoRef>>>(std::forward<Self>(self).storage);
         return std::forward_like<Self>(b->t);
@@ -994,29 +2465,233 @@ struct HeapStorage {
 
     ~HeapStorage() { reset(); }
 
-  private:
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        *this = HeapStorage{std::in_place_type<T>, std::forward<Args>(args)...};
+        return get<T&>();
+    }
+
     void reset() {
         if (storage == nullptr)
             return;
         std::invoke(funPtr(), Op::DEL, storage);
+        storage = nullptr;
     }
+
+  private:
     auto funPtr() const { return *static_cast<const Ptr*>(storage); }
 };
 
-struct MaybeOnHeap {
-    bool isOnHeapValue;
+// The way to destroy the object held by a `TrivialAny`, null if there's nothing to do.
+struct MaybeDestroy {
+    using Destroy = void (*)(void*);
+    Destroy destroy;
 
-    explicit operator bool() const { return isOnHeapValue; }
+    MaybeDestroy(Destroy d) : destroy{d} {}
+    Destroy get() const { return destroy; }
 };
 
-struct IsNotOnHeap {
-    IsNotOnHeap(bool) {}
+// A `TrivialAny` that can't allocate only holds trivially destructible objects.
+struct NeverDestroy {
+    using Destroy = void (*)(void*);
 
-    explicit operator bool() const { return false; }
+    NeverDestroy(Destroy) {}
+    static Destroy get() { return nullptr; }
 };
 
 } // namespace detail
 
+// Same as `DynamicAny`, but the deleter (and the copier) precedes the object in the heap block, so
+// the handle is a single pointer.
+template <Copy kCopy = Copy::ENABLED, typename Alloc = DefaultAllocator>
+struct ThinDynamicAny : detail::HeapStorage<kCopy, Alloc> {
+    using detail::HeapStorage<kCopy, Alloc>::HeapStorage;
+    ThinDynamicAny() = default;
+
+    // Shadow the inherited ones to consult the storage_policy, keyed on ThinDynamicAny.
+    template <typename T, typename TnoRef = std::remove_cvref_t<T>>
+        requires(!std::is_same_v<TnoRef, ThinDynamicAny>)
+    explicit ThinDynamicAny(T&& t)
+          : ThinDynamicAny{std::in_place_type<TnoRef>, std::forward<T>(t)} {}
+
+    template <typename T, typename... Args>
+    explicit ThinDynamicAny(std::in_place_type_t<T> tag, Args&&... args)
+          : detail::HeapStorage<kCopy, Alloc>{tag, std::forward<Args>(args)...} {
+        detail::checkHeapOnlyPolicy<T, ThinDynamicAny>();
+    }
+
+    template <typename T>
+    ThinDynamicAny(TransferOwnership, T* tPtr)
+        requires(!std::is_const_v<T>)
+          : detail::HeapStorage<kCopy, Alloc>{kTransferOwnership, tPtr} {
+        detail::checkHeapOnlyPolicy<T, ThinDynamicAny>();
+    }
+};
+
+// Copy-on-write. A single pointer to a heap block shared by the copies, the block starting with a
+// refcount and a pointer to the deleter/cloner. Copying is a refcount bump. Getting a non-const
+// reference to the object clones the block first, unless this is its only owner.
+//
+// The clone happens when the reference is taken, not when it is written through. Hence a non-const
+// reference must not be kept across a copy: the copy shares the block, and the writes through the
+// reference show in both. Get the reference again after copying.
+template <RefCount kRefCount = RefCount::ATOMIC, typename Alloc_ = DefaultAllocator>
+class CowAny {
+  private:
+    static constexpr bool kIsAtomic = kRefCount == RefCount::ATOMIC;
+    enum Op { DEL, CPY };
+    using Ptr = void* (*)(Op, void*);
+
+    struct Header {
+        Ptr ptr;
+        std::conditional_t<kIsAtomic, std::atomic<size_t>, size_t> refs;
+    };
+
+    template <typename T>
+    struct Blk {
+        Header header;
+        T t;
+        template <typename... Args>
+        Blk(Ptr ptr, Args&&... args) : header{ptr, 1}, t{std::forward<Args&&>(args)...} {}
+    };
+
+    Header* blk;
+
+    template <typename T>
+    static void* manage(Op op, void* p) {
+        auto* b = static_cast<Blk<T>*>(p);
+        if (op == Op::DEL) {
+            Alloc::del(b);
+            return nullptr;
+        }
+        return &Alloc::template make<Blk<T>>(&manage<T>, std::as_const(b->t))->header;
+    }
+
+  public:
+    using Alloc = Alloc_;
+    inline static constexpr auto kExceptionGuarantee = ExceptionGuarantee::STRONG;
+    inline static constexpr auto kStaticStorageSize = 0;
+    inline static constexpr auto kStaticStorageAlignment = 0;
+    inline static constexpr auto kSafeAnyCast = SafeAnyCast::DISABLED;
+
+    // Holds nothing, as if moved from.
+    constexpr CowAny() : blk{nullptr} {}
+
+    template <typename T, typename TnoRef = std::remove_cvref_t<T>>
+        requires(!std::is_same_v<TnoRef, CowAny>)
+    explicit CowAny(T&& t) : CowAny{std::in_place_type<TnoRef>, std::forward<T>(t)} {}
+
+    template <typename T, typename... Args>
+    explicit CowAny(std::in_place_type_t<T>, Args&&... args) {
+        static_assert(std::is_copy_constructible_v<T>, "A shared object is cloned by copying.");
+        SUPPRESS_OFFSETOF_WARNING_START
+        // See the note in `detail::HeapStorage`.
+        static_assert(offsetof(Blk<T>, header) == 0);
+        SUPPRESS_OFFSETOF_WARNING_END
+        detail::checkHeapOnlyPolicy<T, CowAny>();
+        blk = &Alloc::template make<Blk<T>>(&manage<T>, std::forward<Args>(args)...)->header;
+    }
+
+    template <typename T>
+    CowAny(TransferOwnership, T* tPtr)
+        requires(!std::is_const_v<T>)
+          : CowAny{std::in_place_type<T>, std::move(*tPtr)} {
+        Alloc::del(tPtr);
+    }
+
+    CowAny(const CowAny& other) noexcept : blk{other.blk} { acquire(); }
+    CowAny& operator=(const CowAny& other) noexcept {
+        *this = CowAny{other};
+        return *this;
+    }
+
+    CowAny(CowAny&& other) noexcept : blk{std::exchange(other.blk, nullptr)} {}
+    CowAny& operator=(CowAny&& other) noexcept {
+        if (this != &other) {
+            unref();
+            blk = std::exchange(other.blk, nullptr);
+        }
+        return *this;
+    }
+
+    ~CowAny() { unref(); }
+
+    template <typename T, typename Self>
+    T get(this Self&& self) {
+        using TnoRef = std::remove_reference_t<T>;
+        if constexpr (!detail::IsConstRef<Self> && std::is_reference_v<T>
+                      && !std::is_const_v<TnoRef>) {
+            self.detach();
+        }
+        auto* b = reinterpret_cast<detail::RetainConstPtr<Self, Blk<std::remove_cv_t<TnoRef>>>>(
+            std::forward<Self>(self).blk);
+        return detail::star<T, Self>(&b->t);
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        *this = CowAny{std::in_place_type<T>, std::forward<Args>(args)...};
+        return get<T&>();
+    }
+
+    void reset() {
+        unref();
+        blk = nullptr;
+    }
+
+    // Whether the block is shared with another copy, i.e. whether a mutation would clone it.
+    bool isShared() const { return blk != nullptr && refs() != 1; }
+
+    void swap(CowAny& other) noexcept { std::swap(blk, other.blk); }
+
+    template <typename S>
+        requires std::derived_from<S, CowAny>
+    friend void swap(S& a, S& b) noexcept {
+        a.swap(b);
+    }
+
+  private:
+    size_t refs() const {
+        if constexpr (kIsAtomic) {
+            return blk->refs.load(std::memory_order_acquire);
+        } else {
+            return blk->refs;
+        }
+    }
+
+    void acquire() const {
+        if (blk == nullptr)
+            return;
+        if constexpr (kIsAtomic) {
+            blk->refs.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++blk->refs;
+        }
+    }
+
+    void unref() {
+        if (blk == nullptr)
+            return;
+        bool last;
+        if constexpr (kIsAtomic) {
+            last = blk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        } else {
+            last = --blk->refs == 0;
+        }
+        if (last)
+            std::invoke(blk->ptr, Op::DEL, blk);
+    }
+
+    // Makes this the only owner of its block.
+    void detach() {
+        if (isShared()) {
+            auto* copy = static_cast<Header*>(std::invoke(blk->ptr, Op::CPY, blk));
+            unref();
+            blk = copy;
+        }
+    }
+};
+
 template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
           Copy kCopy = Copy::ENABLED,
           size_t kAlignment = alignof(detail::HeapStorage<Copy::ENABLED>),
@@ -1025,22 +2700,52 @@ template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
           typename HS = detail::HeapStorage<kCopy, Alloc_>>
     requires(kSize >= sizeof(HS) && kAlignment >= alignof(HS)) class TrivialAny {
   private:
-    using IsOnHeap = std::conditional_t<kCanAllocate, detail::MaybeOnHeap, detail::IsNotOnHeap>;
-    [[no_unique_address]] IsOnHeap isOnHeap;
+    using Destroyer = std::conditional_t<kCanAllocate, detail::MaybeDestroy, detail::NeverDestroy>;
+    [[no_unique_address]] Destroyer destroy;
     alignas(kAlignment) std::array<char, kSize> storage;
 
     static constexpr bool kIsMoveOnly = kCopy == Copy::DISABLED;
 
     template <typename T>
-    constexpr inline static bool kIsTriviallyRelocatable
-        = std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>;
+    static consteval Sbo sbo() {
+        constexpr auto kPlacement = storage_policy_v<T, TrivialAny>;
+        constexpr bool kTrivial = is_trivially_relocatable_v<T>
+                                  && (kIsMoveOnly || std::is_trivially_copy_constructible_v<T>)
+                                  && (kCanAllocate || std::is_trivially_destructible_v<T>);
+        constexpr auto kFit = sizeof(T) > kSize         ? Sbo::TOO_BIG
+                              : alignof(T) > kAlignment ? Sbo::OVER_ALIGNED
+                              : !kTrivial               ? Sbo::NOT_TRIVIAL
+                                                        : Sbo::INLINE;
+        static_assert(kPlacement != Placement::ARENA,
+                      "storage_policy: the storage doesn't take an arena");
+        if constexpr (kPlacement == Placement::INLINE) {
+            static_assert(kFit != Sbo::TOO_BIG && kFit != Sbo::OVER_ALIGNED,
+                          "storage_policy: the object doesn't fit the buffer");
+            static_assert(kFit != Sbo::NOT_TRIVIAL,
+                          "storage_policy: the object can't be memcpy-ed inline");
+            return Sbo::INLINE;
+        } else if constexpr (kPlacement == Placement::HEAP) {
+            return Sbo::HEAP_POLICY;
+        } else {
+            return kFit;
+        }
+    }
+
+    template <typename T>
+    constexpr inline static bool kOnHeap = sbo<T>() != Sbo::INLINE;
+
+    WOID_NO_ICF static void destroyHs(void* p) { static_cast<HS*>(p)->~HS(); }
+
+    template <typename T>
+    static void destroyInline(void* p) {
+        static_cast<T*>(p)->~T();
+    }
 
     template <typename T>
-    constexpr inline static bool kOnHeap
-        = sizeof(T) > kSize
-          || alignof(T) > kAlignment
-          || !kIsTriviallyRelocatable<T>
-          || (!kIsMoveOnly && !std::is_trivially_copy_constructible_v<T>);
+    static constexpr typename Destroyer::Destroy kDestroy = kOnHeap<T> ? &destroyHs
+                                                          : std::is_trivially_destructible_v<T>
+                                                              ? nullptr
+                                                              : &destroyInline<T>;
 
   public:
     inline static constexpr auto kExceptionGuarantee = ExceptionGuarantee::STRONG;
@@ -1049,9 +2754,16 @@ template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
     inline static constexpr auto kSafeAnyCast = SafeAnyCast::DISABLED;
     using Alloc = HS::Alloc;
 
+    // Whether a `T` is held inline, see `sbo_report`.
+    template <typename T>
+    inline static constexpr Sbo kSbo = sbo<T>();
+
+    // Holds nothing, as if moved from.
+    TrivialAny() : destroy{nullptr}, storage{} {}
+
     template <typename T, typename... Args, typename TnoRef = std::remove_cvref_t<T>>
         requires(kCanAllocate || !kOnHeap<TnoRef>)
-    TrivialAny(std::in_place_type_t<T>, Args&&... args) : isOnHeap(kOnHeap<TnoRef>) {
+    TrivialAny(std::in_place_type_t<T>, Args&&... args) : destroy(kDestroy<TnoRef>) {
         if constexpr (kOnHeap<TnoRef>) {
             new (&storage) HS{std::in_place_type<TnoRef>, std::forward<Args>(args)...};
         } else {
@@ -1059,10 +2771,17 @@ template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
         }
     }
 
+    // The object is moved into the buffer if it fits, otherwise into a block of `HS`, which needs
+    // its header. Either way the block at `tPtr` is freed.
     template <typename T>
-        requires(kCanAllocate) TrivialAny(TransferOwnership, T* tPtr) : isOnHeap(true) {
-        new (&storage) HS{std::move(*tPtr)};
-        Alloc::del(tPtr);
+        requires(!std::is_const_v<T> && (kCanAllocate || !kOnHeap<T>))
+    TrivialAny(TransferOwnership, T* tPtr) : destroy(kDestroy<T>) {
+        if constexpr (kOnHeap<T>) {
+            new (&storage) HS{kTransferOwnership, tPtr};
+        } else {
+            new (&storage) T{std::move(*tPtr)};
+            Alloc::del(tPtr);
+        }
     }
 
     template <typename T, typename TnoRef = std::remove_cvref_t<T>>
@@ -1074,8 +2793,8 @@ template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
 
     TrivialAny(const TrivialAny& other)
         requires(!kIsMoveOnly)
-          : isOnHeap(other.isOnHeap) {
-        if (isOnHeap) {
+          : destroy(other.destroy) {
+        if (isOnHeap()) {
             new (&storage) HS{other.getHs()};
         } else {
             storage = other.storage;
@@ -1088,29 +2807,33 @@ template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
         return *this;
     }
 
-    TrivialAny(TrivialAny&& other) noexcept : isOnHeap(other.isOnHeap) {
-        if (isOnHeap) {
-            new (&storage) HS{std::move(other).getHs()};
-            other.isOnHeap = IsOnHeap{false};
-        } else {
-            this->storage = other.storage;
-        }
+    // Whatever is held, moving is a memcpy as `HS` is trivially relocatable too.
+    TrivialAny(TrivialAny&& other) noexcept : destroy(other.destroy), storage(other.storage) {
+        other.destroy = Destroyer{nullptr};
     }
 
     TrivialAny& operator=(TrivialAny&& other) noexcept {
         if (this != &other) {
             reset();
-            isOnHeap = other.isOnHeap;
-            if (isOnHeap) {
-                new (&storage) HS{std::move(other).getHs()};
-            } else {
-                this->storage = other.storage;
-            }
-            other.isOnHeap = IsOnHeap{false};
+            destroy = other.destroy;
+            storage = other.storage;
+            other.destroy = Destroyer{nullptr};
         }
         return *this;
     }
 
+    // A byte swap, for the same reason.
+    void swap(TrivialAny& other) noexcept {
+        std::swap(destroy, other.destroy);
+        std::swap(storage, other.storage);
+    }
+
+    template <typename S>
+        requires std::derived_from<S, TrivialAny>
+    friend void swap(S& a, S& b) noexcept {
+        a.swap(b);
+    }
+
     template <typename T, typename Self>
     T get(this Self&& self) {
         using TnoRef = std::remove_cvref_t<T>;
@@ -1121,19 +2844,30 @@ template <size_t kSize = sizeof(detail::HeapStorage<Copy::ENABLED>),
         return detail::star<T, Self>(p);
     }
 
+    // Constructed aside and memcpy-ed in, which gives the strong guarantee for free.
+    template <typename T, typename... Args>
+        requires(kCanAllocate || !kOnHeap<T>)
+    T& emplace(Args&&... args) {
+        *this = TrivialAny(std::in_place_type<T>, std::forward<Args>(args)...);
+        return get<T&>();
+    }
+
+    void reset() {
+        if (auto d = destroy.get()) {
+            d(&storage);
+        }
+        destroy = Destroyer{nullptr};
+    }
+
   private:
+    bool isOnHeap() const { return destroy.get() == &destroyHs; }
+
     template <typename Self>
     decltype(auto) getHs(this Self&& self) {
         return std::forward_like<Self>(
             *reinterpret_cast<detail::RetainConstPtr<Self, HS>>(&self.storage.front()));
     }
 
-    void reset() {
-        if (isOnHeap) {
-            getHs().~HS();
-        }
-    }
-
     template <typename Self>
     decltype(auto) ptr(this Self&& self) {
         return detail::ptr<Self>(std::forward<Self>(self).storage);
@@ -1166,11 +2900,34 @@ struct TrivialAnyBuilderImpl {
 
     template <typename NewAlloc>
     using WithAllocator = TrivialAnyBuilderImpl<kSize, kCopy, kAlignment, kCanAllocate, NewAlloc>;
+
+    // The smallest buffer holding any of `Ts`, see `sbo_report` for what else keeps them inline.
+    template <typename... Ts>
+    using FitFor = WithSize<std::max({sizeof(HeapStorage<kCopy, Alloc_>), sizeof(Ts)...})>::
+        template WithAlignment<std::max({alignof(HeapStorage<kCopy, Alloc_>), alignof(Ts)...})>;
 };
 } // namespace detail
 
 using TrivialAnyBuilder = detail::TrivialAnyBuilderImpl<>;
 
+// How a `T` fits the buffer of an SBO storage, `Any` or `TrivialAny`.
+struct SboFit {
+    Sbo sbo;
+    size_t size;
+    size_t alignment;
+
+    constexpr bool isInline() const { return sbo == Sbo::INLINE; }
+};
+
+// Tells for each of `Ts` if `Storage` holds it inline, and if not, why. Meant for static_asserts
+// keeping the hot types off the heap:
+//     static_assert(std::ranges::all_of(sbo_report<Storage, Ts...>(), &SboFit::isInline));
+template <typename Storage, typename... Ts>
+    requires(requires { Storage::template kSbo<Ts>; } && ...)
+constexpr std::array<SboFit, sizeof...(Ts)> sbo_report() {
+    return {SboFit{Storage::template kSbo<Ts>, sizeof(Ts), alignof(Ts)}...};
+}
+
 struct Ref : detail::RefImpl<false> {
     using detail::RefImpl<false>::RefImpl;
 
@@ -1180,7 +2937,7 @@ struct Ref : detail::RefImpl<false> {
 struct CRef : detail::RefImpl<true> {
     using detail::RefImpl<true>::RefImpl;
 
-    CRef(Ref ref) : detail::RefImpl<true>{ConversionTag{}, ref.obj} {}
+    constexpr CRef(Ref ref) : detail::RefImpl<true>{ConversionTag{}, ref.obj} {}
 };
 
 namespace detail {
@@ -1191,7 +2948,10 @@ template <size_t Size = 8,
           size_t Alignment = alignof(void*),
           FunPtr kFunPtr = FunPtr::COMBINED,
           SafeAnyCast kSafeAnyCast = SafeAnyCast::DISABLED,
-          typename Alloc = DefaultAllocator>
+          typename Alloc = DefaultAllocator,
+          Hash kHash = Hash::DISABLED,
+          Equality kEquality = Equality::DISABLED,
+          Thunks kThunks = Thunks::PER_TYPE>
 struct AnyBuilderImpl {
   private:
     template <auto V>
@@ -1200,24 +2960,96 @@ struct AnyBuilderImpl {
         static_assert(std::is_same_v<VType, Copy>
                           || std::is_same_v<VType, ExceptionGuarantee>
                           || std::is_same_v<VType, FunPtr>
-                          || std::is_same_v<VType, SafeAnyCast>,
+                          || std::is_same_v<VType, SafeAnyCast>
+                          || std::is_same_v<VType, Hash>
+                          || std::is_same_v<VType, Equality>
+                          || std::is_same_v<VType, Thunks>,
                       "Template parameter V must be an enum constant of type Copy, "
-                      "ExceptionGuarantee, FunPtr, or SafeAnyCast.");
+                      "ExceptionGuarantee, FunPtr, SafeAnyCast, Hash, Equality or Thunks.");
         static consteval auto chooseType() {
             if constexpr (std::is_same_v<VType, Copy>) {
-                return TypeTag<
-                    AnyBuilderImpl<Size, V, Eg, Alignment, kFunPtr, kSafeAnyCast, Alloc>>{};
+                return TypeTag<AnyBuilderImpl<Size,
+                                              V,
+                                              Eg,
+                                              Alignment,
+                                              kFunPtr,
+                                              kSafeAnyCast,
+                                              Alloc,
+                                              kHash,
+                                              kEquality,
+                                              kThunks>>{};
             }
             if constexpr (std::is_same_v<VType, ExceptionGuarantee>) {
-                return TypeTag<
-                    AnyBuilderImpl<Size, kCopy, V, Alignment, kFunPtr, kSafeAnyCast, Alloc>>{};
+                return TypeTag<AnyBuilderImpl<Size,
+                                              kCopy,
+                                              V,
+                                              Alignment,
+                                              kFunPtr,
+                                              kSafeAnyCast,
+                                              Alloc,
+                                              kHash,
+                                              kEquality,
+                                              kThunks>>{};
             }
             if constexpr (std::is_same_v<VType, FunPtr>) {
-                return TypeTag<
-                    AnyBuilderImpl<Size, kCopy, Eg, Alignment, V, kSafeAnyCast, Alloc>>{};
+                return TypeTag<AnyBuilderImpl<Size,
+                                              kCopy,
+                                              Eg,
+                                              Alignment,
+                                              V,
+                                              kSafeAnyCast,
+                                              Alloc,
+                                              kHash,
+                                              kEquality,
+                                              kThunks>>{};
             }
             if constexpr (std::is_same_v<VType, SafeAnyCast>) {
-                return TypeTag<AnyBuilderImpl<Size, kCopy, Eg, Alignment, kFunPtr, V, Alloc>>{};
+                return TypeTag<AnyBuilderImpl<Size,
+                                              kCopy,
+                                              Eg,
+                                              Alignment,
+                                              kFunPtr,
+                                              V,
+                                              Alloc,
+                                              kHash,
+                                              kEquality,
+                                              kThunks>>{};
+            }
+            if constexpr (std::is_same_v<VType, Hash>) {
+                return TypeTag<AnyBuilderImpl<Size,
+                                              kCopy,
+                                              Eg,
+                                              Alignment,
+                                              kFunPtr,
+                                              kSafeAnyCast,
+                                              Alloc,
+                                              V,
+                                              kEquality,
+                                              kThunks>>{};
+            }
+            if constexpr (std::is_same_v<VType, Equality>) {
+                return TypeTag<AnyBuilderImpl<Size,
+                                              kCopy,
+                                              Eg,
+                                              Alignment,
+                                              kFunPtr,
+                                              kSafeAnyCast,
+                                              Alloc,
+                                              kHash,
+                                              V,
+                                              kThunks>>{};
+            }
+            if constexpr (std::is_same_v<VType, Thunks>) {
+                return TypeTag<AnyBuilderImpl<Size,
+                                              kCopy,
+                                              Eg,
+                                              Alignment,
+                                              kFunPtr,
+                                              kSafeAnyCast,
+                                              Alloc,
+                                              kHash,
+                                              kEquality,
+                                              V>>{};
             }
         }
 
@@ -1229,15 +3061,40 @@ struct AnyBuilderImpl {
 
   public:
     template <size_t NewSize>
-    using WithSize = AnyBuilderImpl<NewSize, kCopy, Eg, Alignment, kFunPtr, kSafeAnyCast, Alloc>;
+    using WithSize = AnyBuilderImpl<NewSize,
+                                    kCopy,
+                                    Eg,
+                                    Alignment,
+                                    kFunPtr,
+                                    kSafeAnyCast,
+                                    Alloc,
+                                    kHash,
+                                    kEquality,
+                                    kThunks>;
 
     template <size_t NewAlignment>
-    using WithAlignment
-        = AnyBuilderImpl<Size, kCopy, Eg, NewAlignment, kFunPtr, kSafeAnyCast, Alloc>;
+    using WithAlignment = AnyBuilderImpl<Size,
+                                         kCopy,
+                                         Eg,
+                                         NewAlignment,
+                                         kFunPtr,
+                                         kSafeAnyCast,
+                                         Alloc,
+                                         kHash,
+                                         kEquality,
+                                         kThunks>;
 
     template <typename NewAlloc>
-    using WithAllocator
-        = AnyBuilderImpl<Size, kCopy, Eg, Alignment, kFunPtr, kSafeAnyCast, NewAlloc>;
+    using WithAllocator = AnyBuilderImpl<Size,
+                                         kCopy,
+                                         Eg,
+                                         Alignment,
+                                         kFunPtr,
+                                         kSafeAnyCast,
+                                         NewAlloc,
+                                         kHash,
+                                         kEquality,
+                                         kThunks>;
 
     using EnableCopy = With<Copy::ENABLED>;
     using DisableCopy = With<Copy::DISABLED>;
@@ -1245,14 +3102,37 @@ struct AnyBuilderImpl {
     using WithNoExceptionGuarantee = With<ExceptionGuarantee::NONE>;
     using WithBasicExceptionGuarantee = With<ExceptionGuarantee::BASIC>;
     using WithStrongExceptionGuarantee = With<ExceptionGuarantee::STRONG>;
+    using WithStrongDoubleBufferExceptionGuarantee
+        = With<ExceptionGuarantee::STRONG_DOUBLE_BUFFER>;
 
     using WithDedicatedFunPtr = With<FunPtr::DEDICATED>;
     using WithCombinedFunPtr = With<FunPtr::COMBINED>;
 
     using EnableSafeAnyCast = With<SafeAnyCast::ENABLED>;
+    using EnableSafeAnyCastByTypeName = With<SafeAnyCast::TYPE_NAME>;
     using DisableSafeAnyCast = With<SafeAnyCast::DISABLED>;
 
-    using Build = Any<Size, kCopy, Eg, Alignment, kFunPtr, kSafeAnyCast, Alloc>;
+    using WithHash = With<Hash::ENABLED>;
+    using WithEquality = With<Equality::ENABLED>;
+
+    using WithPerTypeThunks = With<Thunks::PER_TYPE>;
+    using WithSharedThunks = With<Thunks::SHARED>;
+
+    // The smallest buffer holding any of `Ts`, see `sbo_report` for what else keeps them inline.
+    template <typename... Ts>
+    using FitFor = WithSize<std::max({sizeof(void*), sizeof(Ts)...})>::template WithAlignment<
+        std::max({alignof(void*), alignof(Ts)...})>;
+
+    using Build = Any<Size,
+                      kCopy,
+                      Eg,
+                      Alignment,
+                      kFunPtr,
+                      kSafeAnyCast,
+                      Alloc,
+                      kHash,
+                      kEquality,
+                      kThunks>;
 };
 
 template <typename T>
@@ -1289,6 +3169,14 @@ struct MethodType {
     static inline constexpr bool IsConst = Free<Ptr>::kIsStorageConst;
 };
 
+template <auto L>
+struct BinaryMethodType {
+    using SomeArbitraryCompleteType = int;
+    using Ptr = decltype(&decltype(L)::template operator()<SomeArbitraryCompleteType,
+                                                            SomeArbitraryCompleteType>);
+    using R = Free<Ptr>::R;
+};
+
 } // namespace detail
 
 using AnyBuilder = detail::AnyBuilderImpl<>;
@@ -1299,9 +3187,24 @@ template <typename Storage, typename... Fs>
 
     template <typename T>
     explicit Fun(T&& t)
-          : detail::MonoFun<Storage, Fs>{std::forward<T>(t)}..., storage{std::forward<T>(t)} {}
+          : detail::MonoFun<Storage, Fs>{std::forward<T>(t)}...,
+            storage{mkStorage(std::forward<T>(t))} {}
 
     using detail::MonoFun<Storage, Fs>::operator()...;
+
+  private:
+    // A stateless callable is never read, nor is a `CpuDispatch`, whose pick is in the function
+    // pointer. Hence the storage is left empty: copying, moving and destroying it do nothing.
+    template <typename T>
+    static std::remove_cv_t<Storage> mkStorage(T&& t) {
+        using TnoCvRef = std::remove_cvref_t<T>;
+        if constexpr ((detail::kIsStateless<TnoCvRef> || detail::kIsCpuDispatch<TnoCvRef>)
+                      && std::is_default_constructible_v<std::remove_cv_t<Storage>>) {
+            return {};
+        } else {
+            return std::remove_cv_t<Storage>{std::forward<T>(t)};
+        }
+    }
 };
 
 template <typename... Fs>
@@ -1313,7 +3216,7 @@ template <typename... Fs>
     std::conditional_t<kIsConst, CRef, Ref> storage;
 
     template <typename T>
-    explicit FunRef(T* t) : detail::MonoFunRef<Fs>{t}..., storage{*t} {}
+    constexpr explicit FunRef(T* t) : detail::MonoFunRef<Fs>{t}..., storage{*t} {}
 
     using detail::MonoFunRef<Fs>::operator()...;
 };
@@ -1340,6 +3243,10 @@ struct Interface {
   private:
     detail::HasOrIsVTable<O, Storage_, Ms...> vtable;
     Storage_ storage;
+    [[no_unique_address]] mutable detail::Caches<Ms...> caches;
+
+    static_assert(!(detail::kIsCached<Ms> || ...) || !detail::kIsView<Storage_>,
+                  "CachedFun: a Ref/CRef doesn't own the object, hence can't keep a cache of it");
 
   public:
     using Storage = Storage_;
@@ -1348,18 +3255,158 @@ struct Interface {
 
     template <detail::FixedString Name, typename... Args, typename Self>
     constexpr inline decltype(auto) call(this Self&& self, Args&&... args) {
-        return self.vtable.template getMethod<Name, Args&&...>()->invoke(
-            self.storage, std::forward<Args&&>(args)...);
+        return self.caches.invoke(self.vtable.template getMethod<Name, Args&&...>(),
+                                  self.storage,
+                                  std::forward<Args&&>(args)...);
+    }
+
+    // Calls a `BinaryFun`.
+    template <detail::FixedString Name, typename Self>
+    decltype(auto) callBinary(this const Self& self, const Self& other) {
+        return self.vtable.template getMethod<Name, detail::BinaryTag>()->invoke(
+            self.storage,
+            other.storage,
+            *other.vtable.template getMethod<Name, detail::BinaryTag>(),
+            self,
+            other);
+    }
+
+    // The runtime counterpart of `call`. Throws `UnknownMethod` if no method called `name` accepts
+    // `args`, or if its result doesn't convert to `R`.
+    template <typename R = void, typename... Args, typename Self>
+    R callByName(this Self&& self, std::string_view name, Args&&... args) {
+        using I = std::conditional_t<detail::IsConstRef<Self>, const Interface, Interface>;
+        return detail::ByName<Ms...>::template call<R, I>(self, name, std::forward<Args>(args)...);
+    }
+
+    // Constant expressions too, if the storage allows, e.g. with `Ref`/`CRef`.
+    template <typename T>
+    constexpr Interface(T&& t)
+        requires(!std::is_same_v<std::remove_cvref_t<T>, Interface>)
+          : vtable{detail::TypeTag<T>{}}, storage{std::forward<T>(t)} {}
+
+    template <typename T, typename... Args>
+    constexpr Interface(std::in_place_type_t<T> tag, Args&&... args)
+          : vtable{detail::TypeTag<T>{}}, storage{tag, std::forward<Args>(args)...} {}
+
+    // Replaces the object with a `T`, if the storage can do so in place.
+    template <typename T, typename... Args>
+        requires requires(Storage_ s, Args&&... args) {
+            s.template emplace<T>(std::forward<Args>(args)...);
+        }
+    T& emplace(Args&&... args) {
+        auto& t = storage.template emplace<T>(std::forward<Args>(args)...);
+        vtable = detail::HasOrIsVTable<O, Storage_, Ms...>{detail::TypeTag<T>{}};
+        caches.invalidate();
+        return t;
+    }
+
+    void reset()
+        requires requires(Storage_ s) { s.reset(); } {
+        storage.reset();
+        caches.invalidate();
+    }
+
+    // Swaps the storages with their own `swap`, which relocates rather than makes three moves.
+    void swap(Interface& other) noexcept(std::is_nothrow_swappable_v<Storage_>) {
+        using std::swap;
+        swap(vtable, other.vtable);
+        swap(storage, other.storage);
+        swap(caches, other.caches);
+    }
+
+    template <typename I>
+        requires std::derived_from<I, Interface>
+    friend void swap(I& a, I& b) noexcept(std::is_nothrow_swappable_v<Storage_>) {
+        static_cast<Interface&>(a).swap(b);
+    }
+};
+
+template <typename Storage_, typename... Ms>
+struct Interface<VTableOwnership::UNIFIED, Storage_, Ms...> {
+  private:
+    using Table = detail::UnifiedVTable<Storage_, Ms...>;
+
+    template <typename T>
+    static constexpr inline Table vTableStatic = Table{detail::TypeTag<T>{}};
+
+    detail::UnifiedStorage<Storage_, Ms...> storage;
+    [[no_unique_address]] mutable detail::Caches<
+        typename Ms::template WithStorage<detail::UnifiedStorage<Storage_, Ms...>>...> caches;
+
+  public:
+    using Storage = Storage_;
+    constexpr static inline auto kVTableOwnership = VTableOwnership::UNIFIED;
+    using Self = Interface;
+
+    template <detail::FixedString Name, typename... Args, typename Self>
+    constexpr inline decltype(auto) call(this Self&& self, Args&&... args) {
+        return self.caches.invoke(
+            self.storage.getManager()
+                ->template findMethod<Name, detail::IsConstRef<Self>, Args&&...>(),
+            self.storage,
+            std::forward<Args&&>(args)...);
+    }
+
+    // Calls a `BinaryFun`. Same vtable means same type, hence a single indirect call.
+    template <detail::FixedString Name, typename Self>
+    decltype(auto) callBinary(this const Self& self, const Self& other) {
+        const auto* method
+            = self.storage.getManager()->template findMethod<Name, true, detail::BinaryTag>();
+        const auto* otherMethod
+            = other.storage.getManager()->template findMethod<Name, true, detail::BinaryTag>();
+        return method->invoke(self.storage, other.storage, *otherMethod, self, other);
+    }
+
+    // The runtime counterpart of `call`. Throws `UnknownMethod` if no method called `name` accepts
+    // `args`, or if its result doesn't convert to `R`.
+    template <typename R = void, typename... Args, typename Self>
+    R callByName(this Self&& self, std::string_view name, Args&&... args) {
+        using I = std::conditional_t<detail::IsConstRef<Self>, const Interface, Interface>;
+        return detail::ByName<Ms...>::template call<R, I>(self, name, std::forward<Args>(args)...);
     }
 
     template <typename T>
     Interface(T&& t)
         requires(!std::is_same_v<std::remove_cvref_t<T>, Interface>)
-          : vtable{detail::TypeTag<T>{}}, storage{std::forward<T>(t)} {}
+          : storage{&vTableStatic<std::remove_cvref_t<T>>,
+                    std::in_place_type<std::remove_cvref_t<T>>,
+                    std::forward<T>(t)} {}
 
     template <typename T, typename... Args>
     Interface(std::in_place_type_t<T> tag, Args&&... args)
-          : vtable{detail::TypeTag<T>{}}, storage{tag, std::forward<Args>(args)...} {}
+          : storage{&vTableStatic<T>, tag, std::forward<Args>(args)...} {}
+
+    // The vtable pointer is a part of the storage, hence set along.
+    template <typename T, typename... Args>
+        requires requires(detail::UnifiedStorage<Storage_, Ms...> s, Args&&... args) {
+            s.emplace(&vTableStatic<T>, std::in_place_type<T>, std::forward<Args>(args)...);
+        }
+    T& emplace(Args&&... args) {
+        auto& t = storage.emplace(
+            &vTableStatic<T>, std::in_place_type<T>, std::forward<Args>(args)...);
+        caches.invalidate();
+        return t;
+    }
+
+    void reset()
+        requires requires(detail::UnifiedStorage<Storage_, Ms...> s) { s.reset(); } {
+        storage.reset();
+        caches.invalidate();
+    }
+
+    // The vtable pointer is a part of the storage, hence swapped along.
+    void swap(Interface& other) noexcept(std::is_nothrow_swappable_v<Storage_>) {
+        using std::swap;
+        swap(storage, other.storage);
+        swap(caches, other.caches);
+    }
+
+    template <typename I>
+        requires std::derived_from<I, Interface>
+    friend void swap(I& a, I& b) noexcept(std::is_nothrow_swappable_v<Storage_>) {
+        static_cast<Interface&>(a).swap(b);
+    }
 };
 
 template <typename Variant, typename... Ms>
@@ -1379,13 +3426,22 @@ struct SealedInterface {
             self.v, std::forward<Args&&>(args)...);
     }
 
+    // The runtime counterpart of `call`. Throws `UnknownMethod` if no method called `name` accepts
+    // `args`, or if its result doesn't convert to `R`.
+    template <typename R = void, typename... Args, typename Self>
+    R callByName(this Self&& self, std::string_view name, Args&&... args) {
+        using I
+            = std::conditional_t<detail::IsConstRef<Self>, const SealedInterface, SealedInterface>;
+        return detail::ByName<Ms...>::template call<R, I>(self, name, std::forward<Args>(args)...);
+    }
+
     template <typename T>
-    SealedInterface(T&& t)
+    constexpr SealedInterface(T&& t)
         requires(!std::is_same_v<std::remove_cvref_t<T>, SealedInterface>)
           : table{}, v{std::forward<T>(t)} {}
 
     template <typename T, typename... Args>
-    SealedInterface(std::in_place_type_t<T> tag, Args&&... args)
+    constexpr SealedInterface(std::in_place_type_t<T> tag, Args&&... args)
           : table{}, v{tag, std::forward<Args>(args)...} {}
 };
 
@@ -1399,6 +3455,14 @@ struct InterfaceBuilderImpl {
 
     using WithSharedVTable = InterfaceBuilderImpl<VTableOwnership::SHARED, Storage_, Ms...>;
     using WithDedicatedVTable = InterfaceBuilderImpl<VTableOwnership::DEDICATED, Storage_, Ms...>;
+    using WithUnifiedVTable = InterfaceBuilderImpl<VTableOwnership::UNIFIED, Storage_, Ms...>;
+
+    // An 8-byte handle to a heap block headed by the vtable.
+    template <Copy kCopy = Copy::ENABLED, typename Alloc = DefaultAllocator>
+    using WithBoxedStorage
+        = InterfaceBuilderImpl<VTableOwnership::UNIFIED,
+                               Box<kCopy, Alloc>,
+                               typename Ms::template WithStorage<Box<kCopy, Alloc>>...>;
 
     template <typename S>
     using WithStorage = InterfaceBuilderImpl<O, S, typename Ms::template WithStorage<S>...>;
@@ -1407,13 +3471,34 @@ struct InterfaceBuilderImpl {
     using Method
         = InterfaceBuilderImpl<O, Storage_, Ms..., woid::Method<Name, Storage_, M, MethodLam>>;
 
+  private:
     template <detail::FixedString Name, auto L>
-    using Fun = Method<Name, typename detail::MethodType<L>::Type, []<typename T> {
-        using ObjPtr = std::conditional_t<detail::MethodType<L>::IsConst, const T*, T*>;
-        return [](ObjPtr obj, auto&&... args) {
-            return std::invoke(L, *obj, std::forward<decltype(args)>(args)...);
-        };
-    }>;
+    using FunMethod
+        = woid::Method<Name, Storage_, typename detail::MethodType<L>::Type, []<typename T> {
+              using ObjPtr = std::conditional_t<detail::MethodType<L>::IsConst, const T*, T*>;
+              return [](ObjPtr obj, auto&&... args) {
+                  return std::invoke(L, *obj, std::forward<decltype(args)>(args)...);
+              };
+          }>;
+
+  public:
+    template <detail::FixedString Name, auto L>
+    using Fun = InterfaceBuilderImpl<O, Storage_, Ms..., FunMethod<Name, L>>;
+
+    // Like `Fun`, for a pure const method of no arguments. The result is computed once and kept in
+    // the Interface until a non-const method is called through `call`. Filling the cache writes to
+    // the Interface, so unlike the other const calls, concurrent ones on the same Interface race.
+    // Not available over `Ref`/`CRef`, where the object may change without the Interface knowing.
+    template <detail::FixedString Name, auto L>
+    using CachedFun = InterfaceBuilderImpl<O, Storage_, Ms..., CachedMethod<FunMethod<Name, L>>>;
+
+    // `SameLam` gets two objects of the same type, `CrossLam` gets two interfaces otherwise.
+    template <detail::FixedString Name, auto SameLam, auto CrossLam>
+    using BinaryFun = InterfaceBuilderImpl<
+        O,
+        Storage_,
+        Ms...,
+        BinaryMethodImpl<Name, SameLam, CrossLam, Storage_, typename BinaryMethodType<SameLam>::R>>;
 
     using Build = Interface<O, Storage_, Ms...>;
 };
@@ -1444,3 +3529,29 @@ template <typename Variant>
 using SealedInterfaceBuilder = detail::SealedInterfaceBuilderImpl<Variant>;
 
 } // namespace woid WOID_SYMBOL_VISIBILITY_FLAG
+
+// Makes an `Any` with the hash op a key of `std::unordered_map` and alike.
+template <size_t kSize,
+          woid::Copy kCopy,
+          woid::ExceptionGuarantee kEg,
+          size_t kAlignment,
+          woid::FunPtr kFunPtr,
+          woid::SafeAnyCast kSafeAnyCast,
+          typename Alloc,
+          woid::Equality kEquality,
+          woid::Thunks kThunks>
+struct std::hash<woid::Any<kSize,
+                           kCopy,
+                           kEg,
+                           kAlignment,
+                           kFunPtr,
+                           kSafeAnyCast,
+                           Alloc,
+                           woid::Hash::ENABLED,
+                           kEquality,
+                           kThunks>> {
+    template <typename A>
+    size_t operator()(const A& any) const {
+        return any.hash();
+    }
+};
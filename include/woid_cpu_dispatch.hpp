@@ -0,0 +1,99 @@
+#pragma once
+
+#include "woid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace woid WOID_SYMBOL_VISIBILITY_FLAG {
+
+// The x86 instruction sets `CpuDispatch` picks implementations for, ordered by preference.
+enum class CpuLevel { SCALAR, SSE42, AVX2, AVX512 };
+
+namespace detail {
+inline CpuLevel detectCpuLevel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return CpuLevel::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return CpuLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.2"))
+        return CpuLevel::SSE42;
+#endif
+    return CpuLevel::SCALAR;
+}
+
+inline std::optional<CpuLevel> parseCpuLevel(std::string_view name) {
+    constexpr std::array<std::pair<std::string_view, CpuLevel>, 4> kNames{{
+        {"scalar", CpuLevel::SCALAR},
+        {"sse4.2", CpuLevel::SSE42},
+        {"avx2", CpuLevel::AVX2},
+        {"avx512", CpuLevel::AVX512},
+    }};
+    for (const auto& [n, level] : kNames) {
+        if (n == name)
+            return level;
+    }
+    return std::nullopt;
+}
+} // namespace detail
+
+// The best level this CPU supports, detected once. It can be lowered (never raised) by setting the
+// `WOID_CPU_LEVEL` environment variable to one of `scalar`, `sse4.2`, `avx2` and `avx512`, which
+// comes handy to test the fallbacks on a modern machine.
+inline CpuLevel cpuLevel() {
+    static const CpuLevel level = [] {
+        const CpuLevel detected = detail::detectCpuLevel();
+        const char* env = std::getenv("WOID_CPU_LEVEL");
+        const auto requested = env ? detail::parseCpuLevel(env) : std::nullopt;
+        return requested ? std::min(*requested, detected) : detected;
+    }();
+    return level;
+}
+
+// Implementations of the same stateless callable for increasing `CpuLevel`s, starting with the
+// scalar one. If fewer than four are given, the last one serves the higher levels as well.
+//
+// The implementation is picked once, at construction. Wrapped into a `Fun`, it's the picked
+// implementation that lands in the function pointer, hence a call costs a single indirect call
+// and no feature check.
+template <auto... Impls>
+    requires(sizeof...(Impls) > 0 && sizeof...(Impls) <= 4)
+struct CpuDispatch {
+    CpuLevel level;
+
+    explicit CpuDispatch(CpuLevel level = cpuLevel()) : level{level} {}
+
+    // `Wrap.template operator()<Impl>()` must make a `Ptr` calling `Impl`.
+    template <typename Ptr, typename Wrap>
+    Ptr select(Wrap) const {
+        static constexpr std::array<Ptr, sizeof...(Impls)> kPtrs{
+            Wrap{}.template operator()<Impls>()...};
+        return kPtrs[std::min(static_cast<size_t>(level), sizeof...(Impls) - 1)];
+    }
+
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const {
+        using R = std::invoke_result_t<decltype(std::get<0>(std::tuple{Impls...})), Args&&...>;
+        return select<R (*)(Args&&...)>([]<auto Impl> {
+            return +[](Args&&... args) -> R {
+                return std::invoke(Impl, std::forward<Args>(args)...);
+            };
+        })(std::forward<Args>(args)...);
+    }
+};
+
+namespace detail {
+template <auto... Impls>
+constexpr inline bool kIsCpuDispatch<CpuDispatch<Impls...>> = true;
+} // namespace detail
+
+} // namespace woid WOID_SYMBOL_VISIBILITY_FLAG
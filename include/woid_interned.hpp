@@ -0,0 +1,167 @@
+#pragma once
+
+#include "woid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace woid WOID_SYMBOL_VISIBILITY_FLAG {
+
+// Hash-consing. Equal objects of the same type share a single immutable entry of a table, holding
+// the object in a `Storage` along with its hash and a refcount, so the handle is a single pointer.
+// Copying is a refcount bump and equality is a pointer compare. The table is sharded by hash, each
+// shard guarded by a mutex, and an entry leaves it along with its last handle. A stored `T` has to
+// be hashable with `std::hash` and comparable with `==`.
+template <typename Storage = Any<>>
+class Interned {
+  private:
+    struct Entry {
+        template <typename T>
+        Entry(T&& t, size_t hash, const void* type)
+              : value{std::forward<T>(t)}, hash{hash}, type{type}, refs{1} {}
+
+        const Storage value;
+        const size_t hash;
+        const void* const type;
+        std::atomic<size_t> refs;
+    };
+
+    static constexpr size_t kShards = 16;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_multimap<size_t, Entry*> entries;
+    };
+
+    // Never destroyed, as the handles with static storage duration may outlive it.
+    static std::array<Shard, kShards>& shards() {
+        static auto* shards = new std::array<Shard, kShards>{};
+        return *shards;
+    }
+
+    static Shard& shardFor(size_t hash) { return shards()[hash % kShards]; }
+
+    Entry* entry;
+
+  public:
+    using Alloc = Storage::Alloc;
+    inline static constexpr auto kExceptionGuarantee = ExceptionGuarantee::STRONG;
+    inline static constexpr auto kStaticStorageSize = 0;
+    inline static constexpr auto kStaticStorageAlignment = 0;
+    inline static constexpr auto kSafeAnyCast = Storage::kSafeAnyCast;
+
+    template <typename T, typename TnoRef = std::remove_cvref_t<T>>
+        requires(!std::is_same_v<TnoRef, Interned>)
+    explicit Interned(T&& t) {
+        const size_t hash = std::hash<TnoRef>{}(t);
+        Shard& shard = shardFor(hash);
+        std::lock_guard lock{shard.mutex};
+        auto [first, last] = shard.entries.equal_range(hash);
+        for (auto it = first; it != last; ++it) {
+            Entry* e = it->second;
+            if (e->type == &detail::kTypeId<TnoRef> && any_cast<const TnoRef&>(e->value) == t) {
+                e->refs.fetch_add(1, std::memory_order_relaxed);
+                entry = e;
+                return;
+            }
+        }
+        entry = Alloc::template make<Entry>(std::forward<T>(t), hash, &detail::kTypeId<TnoRef>);
+        shard.entries.emplace(hash, entry);
+    }
+
+    template <typename T, typename... Args>
+    explicit Interned(std::in_place_type_t<T>, Args&&... args)
+          : Interned{T{std::forward<Args>(args)...}} {}
+
+    Interned(const Interned& other) noexcept : entry{other.entry} {
+        if (entry != nullptr)
+            entry->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    Interned& operator=(const Interned& other) noexcept {
+        *this = Interned{other};
+        return *this;
+    }
+
+    Interned(Interned&& other) noexcept : entry{std::exchange(other.entry, nullptr)} {}
+    Interned& operator=(Interned&& other) noexcept {
+        if (this != &other) {
+            reset();
+            entry = std::exchange(other.entry, nullptr);
+        }
+        return *this;
+    }
+
+    ~Interned() { reset(); }
+
+    // The object is shared, hence only ever const.
+    template <typename T, typename Self>
+    T get(this Self&& self) {
+        static_assert(!std::is_reference_v<T> || std::is_const_v<std::remove_reference_t<T>>,
+                      "An interned object is immutable.");
+        return any_cast<T>(self.entry->value);
+    }
+
+    size_t hash() const { return entry == nullptr ? 0 : entry->hash; }
+
+    friend bool operator==(const Interned& a, const Interned& b) { return a.entry == b.entry; }
+
+    void reset() {
+        if (entry == nullptr)
+            return;
+        // Lookups take a reference under the shard lock, hence so does the release of the last one.
+        size_t refs = entry->refs.load(std::memory_order_relaxed);
+        while (refs > 1) {
+            if (entry->refs.compare_exchange_weak(refs, refs - 1, std::memory_order_acq_rel)) {
+                entry = nullptr;
+                return;
+            }
+        }
+        Shard& shard = shardFor(entry->hash);
+        {
+            std::lock_guard lock{shard.mutex};
+            if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                auto [first, last] = shard.entries.equal_range(entry->hash);
+                shard.entries.erase(std::find_if(
+                    first, last, [&](const auto& kv) { return kv.second == entry; }));
+            } else {
+                entry = nullptr;
+            }
+        }
+        if (entry != nullptr)
+            Alloc::del(entry);
+        entry = nullptr;
+    }
+
+    void swap(Interned& other) noexcept { std::swap(entry, other.entry); }
+
+    template <typename S>
+        requires std::derived_from<S, Interned>
+    friend void swap(S& a, S& b) noexcept {
+        a.swap(b);
+    }
+
+    // The number of distinct objects interned with this `Storage`.
+    static size_t distinctCount() {
+        size_t n = 0;
+        for (Shard& shard : shards()) {
+            std::lock_guard lock{shard.mutex};
+            n += shard.entries.size();
+        }
+        return n;
+    }
+};
+
+} // namespace woid WOID_SYMBOL_VISIBILITY_FLAG
+
+template <typename Storage>
+struct std::hash<woid::Interned<Storage>> {
+    size_t operator()(const woid::Interned<Storage>& interned) const { return interned.hash(); }
+};
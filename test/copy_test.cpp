@@ -1,6 +1,9 @@
 #define BOOST_TEST_MODULE AnyTest
 
 #include "storage_test_setup.hpp"
+#include "woid_interned.hpp"
+#include <string>
+#include <unordered_map>
 
 template <typename T>
 struct CopyTypesTestCase : BaseTestCase<T> {};
@@ -114,6 +117,18 @@ TYPED_TEST(CopyTypesCopyStorageTestCase, canCopyAssignToMovedFrom) {
     ASSERT_EQ(value.i, kInt);
 }
 
+TYPED_TEST(CopyTypesCopyStorageTestCase, canCopyMovedFrom) {
+    using Storage = TypeParam::Storage;
+    using Value = TypeParam::Value;
+    Storage storage{Value{42}};
+    Storage unused{std::move(storage)};
+    Storage copy{storage};
+    Storage other{Value{kInt}};
+    other = storage;
+    other = Storage{Value{kInt}};
+    ASSERT_EQ(any_cast<Value&>(other).i, kInt);
+}
+
 TEST(FunRef, CanCallOverloaded) {
     constexpr auto add2 = [](int x, int y) { return x + y; };
     constexpr auto add3 = [](int x, int y, int z) { return x + y + z; };
@@ -192,6 +207,380 @@ TEST(Ref, canMoveFrom) {
     ASSERT_EQ(any_cast<int&&>(std::move(ra)), a);
 }
 
+struct Handle {
+    int* counter;
+    explicit Handle(int* counter) : counter(counter) { ++*counter; }
+    Handle(Handle&& other) : counter(std::exchange(other.counter, nullptr)) {}
+    ~Handle() {
+        if (counter)
+            --*counter;
+    }
+};
+
+template <>
+struct woid::is_trivially_relocatable<Handle> : std::true_type {};
+
+template <typename T, typename Storage>
+static bool isInline(Storage& s) {
+    auto* p = reinterpret_cast<char*>(&any_cast<T&>(s));
+    auto* begin = reinterpret_cast<char*>(&s);
+    return begin <= p && p < begin + sizeof(Storage);
+}
+
+TEST(TrivialAny, holdsTriviallyRelocatableInline) {
+    using Storage = TrivialAny<8, Copy::DISABLED>;
+    int alive = 0;
+    {
+        Storage first{Handle{&alive}};
+        Storage second{std::move(first)};
+        Storage third{std::make_unique<int>(kInt)};
+        ASSERT_TRUE(isInline<std::unique_ptr<int>>(third));
+        ASSERT_EQ(*any_cast<std::unique_ptr<int>&>(third), kInt);
+
+        third = std::move(second);
+        ASSERT_TRUE(isInline<Handle>(third));
+        ASSERT_EQ(any_cast<Handle&>(third).counter, &alive);
+        ASSERT_EQ(alive, 1);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(BatchedOps, copyMoveAndDestroyRunsOfAny) {
+    using Storage = Any<>;
+    using Value = C<char>;
+    constexpr size_t N = 5;
+    std::allocator<Storage> alloc;
+    Storage* src = alloc.allocate(N);
+    Storage* copy = alloc.allocate(N);
+    Storage* moved = alloc.allocate(N);
+    new (&src[0]) Storage{1};
+    new (&src[1]) Storage{2};
+    new (&src[2]) Storage{std::in_place_type<Value>, 3};
+    new (&src[3]) Storage{std::in_place_type<Value>, 4};
+    new (&src[4]) Storage{5};
+
+    woid::uninitialized_copy_n(src, N, copy);
+    ASSERT_EQ(Value::cnt, 4);
+    woid::destroy_n(src, N);
+    ASSERT_EQ(Value::cnt, 2);
+
+    woid::uninitialized_move_n(copy, N, moved);
+    woid::destroy_n(copy, N);
+    ASSERT_EQ(Value::cnt, 2);
+    ASSERT_EQ(any_cast<int>(moved[1]), 2);
+    ASSERT_EQ(any_cast<Value&>(moved[3]).i, 4);
+    ASSERT_EQ(any_cast<int>(moved[4]), 5);
+    woid::destroy_n(moved, N);
+    ASSERT_EQ(Value::cnt, 0);
+
+    alloc.deallocate(src, N);
+    alloc.deallocate(copy, N);
+    alloc.deallocate(moved, N);
+}
+
+// Big enough for `Any<8>` to put it on the heap.
+struct Assigned {
+    int i;
+    std::array<char, 12> payload{};
+    inline static int made = 0;
+    inline static int assigned = 0;
+    inline static int destroyed = 0;
+    Assigned(int i) : i(i) { made++; }
+    Assigned(const Assigned& other) : i(other.i) { made++; }
+    Assigned(Assigned&& other) noexcept : i(other.i) { made++; }
+    Assigned& operator=(const Assigned& other) noexcept {
+        i = other.i;
+        assigned++;
+        return *this;
+    }
+    Assigned& operator=(Assigned&& other) noexcept {
+        i = other.i;
+        assigned++;
+        return *this;
+    }
+    ~Assigned() { destroyed++; }
+};
+
+TEST(SameTypeAssignment, reusesTheObject) {
+    // A heap object is moved by stealing its block rather than by an assignment.
+    auto reuses = []<typename Storage>(Storage a, Storage b, bool movesByAssignment) {
+        const int made = Assigned::made;
+        const int assigned = Assigned::assigned;
+        const int destroyed = Assigned::destroyed;
+        b = a;
+        EXPECT_EQ(Assigned::made, made);
+        EXPECT_EQ(Assigned::assigned, assigned + 1);
+        EXPECT_EQ(Assigned::destroyed, destroyed);
+        EXPECT_EQ(any_cast<Assigned&>(b).i, kInt);
+
+        // Either the moved-from object or the one replaced is destroyed.
+        a = std::move(b);
+        EXPECT_EQ(Assigned::made, made);
+        EXPECT_EQ(Assigned::assigned, assigned + (movesByAssignment ? 2 : 1));
+        EXPECT_EQ(Assigned::destroyed, destroyed + 1);
+        EXPECT_EQ(any_cast<Assigned&>(a).i, kInt);
+    };
+    reuses(Any<8>{Assigned{kInt}}, Any<8>{Assigned{42}}, false);
+    reuses(Any<32>{Assigned{kInt}}, Any<32>{Assigned{42}}, true);
+    reuses(DynamicAny<>{Assigned{kInt}}, DynamicAny<>{Assigned{42}}, false);
+    ASSERT_EQ(Assigned::made, Assigned::destroyed);
+}
+
+TEST(EmptyStorage, isCopiedMovedAndFilled) {
+    auto copies = []<typename Storage>(Storage empty) {
+        Storage copy{empty};
+        Storage moved{std::move(copy)};
+        Storage filled{kInt};
+        filled = empty;
+        filled = std::move(moved);
+        filled.template emplace<int>(kInt);
+        EXPECT_EQ(any_cast<int>(filled), kInt);
+    };
+    copies(Any<8>{});
+    copies(Any<32, Copy::ENABLED, ExceptionGuarantee::STRONG_DOUBLE_BUFFER>{});
+    copies(DynamicAny<>{});
+    copies(ThinDynamicAny<>{});
+    copies(Box<>{});
+    ASSERT_EQ(Any<8>{}.getManager(), nullptr);
+}
+
+TEST(DoubleBuffer, tradesSizeAndNoexceptMovesForTheSbo) {
+    using Strong = Any<32, Copy::ENABLED, ExceptionGuarantee::STRONG>;
+    using DoubleBuffer = Any<32, Copy::ENABLED, ExceptionGuarantee::STRONG_DOUBLE_BUFFER>;
+    using ThrowingMove = C<char>;
+    static_assert(!std::is_nothrow_move_constructible_v<ThrowingMove>);
+    static_assert(Strong::kSbo<ThrowingMove> == Sbo::THROWING_MOVE);
+    static_assert(DoubleBuffer::kSbo<ThrowingMove> == Sbo::INLINE);
+    static_assert(sizeof(DoubleBuffer) == sizeof(Strong) + 32);
+    static_assert(std::is_nothrow_move_constructible_v<Strong>);
+    static_assert(!std::is_nothrow_move_constructible_v<DoubleBuffer>);
+}
+
+TEST(CowAny, copiesShareTheObjectUntilOneIsMutated) {
+    using Value = C<char>;
+    {
+        CowAny<> first{Value{kInt}};
+        CowAny<> second = first;
+        ASSERT_TRUE(first.isShared());
+        ASSERT_EQ(&any_cast<const Value&>(first), &any_cast<const Value&>(std::as_const(second)));
+        ASSERT_EQ(Value::cnt, 1);
+
+        any_cast<Value&>(second).i = 42;
+        ASSERT_FALSE(first.isShared());
+        ASSERT_EQ(Value::cnt, 2);
+        ASSERT_EQ(any_cast<const Value&>(first).i, kInt);
+        ASSERT_EQ(any_cast<const Value&>(second).i, 42);
+
+        auto* unshared = &any_cast<Value&>(second);
+        any_cast<Value&>(second).i++;
+        ASSERT_EQ(&any_cast<Value&>(second), unshared);
+    }
+    ASSERT_EQ(Value::cnt, 0);
+}
+
+TEST(CowAny, aReferenceKeptAcrossACopyWritesToBoth) {
+    using Value = C<char>;
+    {
+        CowAny<> first{Value{kInt}};
+        auto& kept = any_cast<Value&>(first);
+        CowAny<> second = first;
+        ASSERT_TRUE(first.isShared());
+        kept.i = 42;
+        ASSERT_EQ(any_cast<const Value&>(std::as_const(second)).i, 42);
+
+        any_cast<Value&>(first).i = kInt;
+        ASSERT_FALSE(first.isShared());
+        ASSERT_EQ(any_cast<const Value&>(std::as_const(first)).i, kInt);
+        ASSERT_EQ(any_cast<const Value&>(std::as_const(second)).i, 42);
+    }
+    ASSERT_EQ(Value::cnt, 0);
+}
+
+TEST(HashedAny, isAHashTableKey) {
+    using Key = AnyBuilder::WithHash::WithEquality::Build;
+    std::unordered_map<Key, int> map;
+    map.emplace(Key{1}, 1);
+    map.emplace(Key{std::string{"1"}}, 2);
+    map.emplace(Key{std::string{"a string too long to be stored inline"}}, 3);
+
+    ASSERT_EQ(map.size(), 3);
+    ASSERT_EQ(map.at(Key{1}), 1);
+    ASSERT_EQ(map.at(Key{std::string{"1"}}), 2);
+    ASSERT_EQ(map.at(Key{std::string{"a string too long to be stored inline"}}), 3);
+    ASSERT_FALSE(map.contains(Key{1L}));
+    ASSERT_FALSE(map.contains(Key{2}));
+
+    ASSERT_EQ(Key{kInt}.hash(), std::hash<int>{}(kInt));
+    ASSERT_NE(Key{1}, Key{1L});
+}
+
+TEST(Visit, dispatchesOnTheStoredType) {
+    using Big = std::array<int, 8>;
+    auto visitor = Overloads{[](int& i) { return i++; },
+                             [](const std::string& s) { return static_cast<int>(s.size()); },
+                             [](const Big& b) { return b[0]; },
+                             [] { return -1; }};
+    Any<> i{kInt};
+    ASSERT_EQ((visit<int, std::string, Big>(i, visitor)), kInt);
+    ASSERT_EQ(any_cast<int>(i), kInt + 1);
+    Any<> str{std::string{"abc"}};
+    ASSERT_EQ((visit<int, std::string, Big>(str, visitor)), 3);
+    Any<> big{Big{kInt}};
+    ASSERT_EQ((visit<int, std::string, Big>(big, visitor)), kInt);
+    Any<> other{1L};
+    ASSERT_EQ((visit<int, std::string, Big>(other, visitor)), -1);
+    ASSERT_EQ(visit<std::string>(Any<>{std::string{"abc"}}, [](std::string&& s) {
+                  return std::move(s);
+              }),
+              "abc");
+
+    ASSERT_EQ(*try_cast<int>(i), kInt + 1);
+    ASSERT_EQ(try_cast<long>(i), nullptr);
+    ASSERT_EQ((*try_cast<Big>(std::as_const(big)))[0], kInt);
+    static_assert(std::is_same_v<decltype(try_cast<Big>(std::as_const(big))), const Big*>);
+}
+
+TEST(Interned, equalObjectsShareAnEntry) {
+    using Handle = Interned<Any<sizeof(std::string)>>;
+    {
+        Handle a{std::string{"config"}};
+        Handle b{std::string{"config"}};
+        Handle c{std::string{"symbol"}};
+        Handle d{kInt};
+        // Same hash, but another type.
+        Handle f{static_cast<unsigned>(kInt)};
+        ASSERT_EQ(a, b);
+        ASSERT_NE(a, c);
+        ASSERT_NE(d, f);
+        ASSERT_EQ(&any_cast<const std::string&>(a), &any_cast<const std::string&>(b));
+        ASSERT_EQ(any_cast<const std::string&>(c), "symbol");
+        ASSERT_EQ(any_cast<int>(d), kInt);
+        ASSERT_EQ(any_cast<unsigned>(f), static_cast<unsigned>(kInt));
+        ASSERT_EQ(Handle::distinctCount(), 4);
+
+        Handle e = std::move(a);
+        b = c;
+        ASSERT_EQ(Handle::distinctCount(), 4);
+        ASSERT_EQ(std::hash<Handle>{}(e), std::hash<std::string>{}("config"));
+    }
+    ASSERT_EQ(Handle::distinctCount(), 0);
+}
+
+struct Cold {
+    int i;
+};
+
+struct Pooled {
+    int i;
+};
+
+struct CountingArena {
+    inline static int blocks = 0;
+
+    template <typename T>
+    static T* make(auto&&... args) {
+        ++blocks;
+        return new T(std::forward<decltype(args)>(args)...);
+    }
+
+    template <typename T>
+    static void del(T* obj) noexcept {
+        --blocks;
+        delete obj;
+    }
+};
+
+using PolicyAny = Any<16>;
+using PolicyTrivialAny = TrivialAny<>;
+
+template <>
+struct woid::storage_policy<Cold, PolicyAny::Woid>
+      : std::integral_constant<Placement, Placement::HEAP> {};
+
+template <>
+struct woid::storage_policy<Cold, PolicyTrivialAny>
+      : std::integral_constant<Placement, Placement::HEAP> {};
+
+template <>
+struct woid::storage_policy<Pooled, PolicyAny::Woid>
+      : std::integral_constant<Placement, Placement::ARENA> {
+    using Arena = CountingArena;
+};
+
+template <typename Storage, typename T>
+concept CanRelease = requires(Storage s) { s.template release<T>(); };
+
+TEST(StoragePolicy, overridesThePlacement) {
+    PolicyAny cold{Cold{kInt}};
+    ASSERT_FALSE(isInline<Cold>(cold));
+    std::unique_ptr<Cold> released{cold.release<Cold>()};
+    ASSERT_EQ(released->i, kInt);
+
+    PolicyTrivialAny trivial{Cold{kInt}};
+    ASSERT_FALSE(isInline<Cold>(trivial));
+    PolicyTrivialAny small{kInt};
+    ASSERT_TRUE(isInline<int>(small));
+
+    {
+        PolicyAny a{Pooled{kInt}};
+        PolicyAny b{a};
+        ASSERT_EQ(CountingArena::blocks, 2);
+        ASSERT_EQ(any_cast<Pooled&>(b).i, kInt);
+        static_assert(!CanRelease<PolicyAny, Pooled>);
+    }
+    ASSERT_EQ(CountingArena::blocks, 0);
+}
+
+TEST(SboReport, tellsWhyAnObjectIsOnTheHeap) {
+    using Wide = std::array<double, 5>;
+    using Fitted = AnyBuilder::FitFor<char, std::string, Wide>::Build;
+    static_assert(Fitted::kStaticStorageSize == std::max(sizeof(std::string), sizeof(Wide)));
+    static_assert(Fitted::kStaticStorageAlignment == alignof(void*));
+    static_assert(std::ranges::all_of(sbo_report<Fitted, char, std::string, Wide>(),
+                                      &SboFit::isInline));
+
+    struct alignas(32) Aligned {};
+    struct ThrowingMove {
+        ThrowingMove(ThrowingMove&&) noexcept(false);
+    };
+    using Strong = AnyBuilder::WithSize<32>::WithStrongExceptionGuarantee::Build;
+    constexpr auto report = sbo_report<Strong, int, Wide, Aligned, ThrowingMove>();
+    static_assert(report[0].isInline());
+    static_assert(report[1].sbo == Sbo::TOO_BIG && report[1].size == sizeof(Wide));
+    static_assert(report[2].sbo == Sbo::OVER_ALIGNED && report[2].alignment == 32);
+    static_assert(report[3].sbo == Sbo::THROWING_MOVE);
+    static_assert(sbo_report<PolicyAny, Cold>()[0].sbo == Sbo::HEAP_POLICY);
+
+    using FittedTrivial = TrivialAnyBuilder::FitFor<Wide>::Build;
+    constexpr auto trivialReport = sbo_report<FittedTrivial, Wide, std::string>();
+    static_assert(trivialReport[0].isInline());
+    static_assert(trivialReport[1].sbo == Sbo::NOT_TRIVIAL);
+}
+
+TEST(SharedThunks, trivialTypesOfASizeShareTheirFunctions) {
+    struct Point {
+        int x, y;
+    };
+    struct Tick {
+        float price;
+        int volume;
+    };
+    using Shared = AnyBuilder::WithSize<16>::EnableSafeAnyCast::WithSharedThunks::Build;
+    static_assert(Shared::kMemManagerFor<Point>.ptr == Shared::kMemManagerFor<Tick>.ptr);
+    static_assert(&Shared::kMemManagerFor<Point> != &Shared::kMemManagerFor<Tick>);
+    static_assert(Shared::kMemManagerFor<Point>.ptr != Shared::kMemManagerFor<int>.ptr);
+    static_assert(Any<16>::kMemManagerFor<Point>.ptr != Any<16>::kMemManagerFor<Tick>.ptr);
+
+    Shared point{Point{kInt, 2 * kInt}};
+    Shared copy{point};
+    ASSERT_EQ(any_cast<Point&>(copy).y, 2 * kInt);
+    ASSERT_EQ(try_cast<Tick>(copy), nullptr);
+
+    copy = Shared{std::string{"not trivial"}};
+    Shared other{copy};
+    ASSERT_EQ(any_cast<std::string&>(other), "not trivial");
+}
+
 #if defined(__cpp_exceptions)
 
 class Bomb {
@@ -224,19 +613,23 @@ class Bomb {
     }
 };
 
-template <ExceptionGuarantee eg>
+template <ExceptionGuarantee... egs>
 constexpr auto filterByEg(auto storages) {
     return hana::filter(storages, [&](auto testCase) {
         using Storage = decltype(testCase)::type;
-        return hana::bool_c < Storage::kExceptionGuarantee == eg > ;
+        return hana::bool_c < ((Storage::kExceptionGuarantee == egs) || ...) > ;
     });
 }
 
 constexpr auto BasicEgMovableStorages = filterByEg<ExceptionGuarantee::BASIC>(AllStorages);
 constexpr auto StrongEgMovableStorages = filterByEg<ExceptionGuarantee::STRONG>(AllStorages);
+constexpr auto DoubleBufferEgMovableStorages
+    = filterByEg<ExceptionGuarantee::STRONG_DOUBLE_BUFFER>(AllStorages);
 
 constexpr auto BasicEgCopyableStorages = filterByEg<ExceptionGuarantee::BASIC>(CopyStorageTypes);
-constexpr auto StrongEgCopyableStorages = filterByEg<ExceptionGuarantee::STRONG>(CopyStorageTypes);
+constexpr auto StrongEgCopyableStorages
+    = filterByEg<ExceptionGuarantee::STRONG, ExceptionGuarantee::STRONG_DOUBLE_BUFFER>(
+        CopyStorageTypes);
 
 template <typename T>
 struct EgTest : ValueCntNuller<Bomb>, AlternativeAllocatorResetter {};
@@ -249,6 +642,10 @@ template <typename T>
 struct StrongEgMovableStorage : EgTest<T> {};
 TYPED_TEST_SUITE(StrongEgMovableStorage, AsTuple<StrongEgMovableStorages>);
 
+template <typename T>
+struct DoubleBufferEgMovableStorage : EgTest<T> {};
+TYPED_TEST_SUITE(DoubleBufferEgMovableStorage, AsTuple<DoubleBufferEgMovableStorages>);
+
 template <typename T>
 struct BasicEgCopyableStorage : EgTest<T> {};
 TYPED_TEST_SUITE(BasicEgCopyableStorage, AsTuple<BasicEgCopyableStorages>);
@@ -282,6 +679,24 @@ TYPED_TEST(StrongEgMovableStorage, throwOnMoveStrong) {
     ASSERT_EQ(Bomb::cnt, 0);
 }
 
+TYPED_TEST(DoubleBufferEgMovableStorage, throwOnMoveStrong) {
+    using Storage = TypeParam;
+    {
+        // Bomb is kept inline if it fits, hence moving it throws
+        Storage first{std::in_place_type<Bomb>, kInt};
+        Storage other{std::in_place_type<Bomb>, 123};
+        try {
+            other = std::move(first);
+            ASSERT_EQ(any_cast<Bomb&>(other).i, kInt);
+        } catch (...) {
+            ASSERT_EQ(any_cast<Bomb&>(first).i, kInt);
+            ASSERT_EQ(any_cast<Bomb&>(other).i, 123);
+            ASSERT_EQ(Bomb::cnt, 2);
+        }
+    }
+    ASSERT_EQ(Bomb::cnt, 0);
+}
+
 TYPED_TEST(BasicEgCopyableStorage, throwOnCopyWeak) {
     using Storage = TypeParam;
     {
@@ -312,6 +727,41 @@ TYPED_TEST(StrongEgCopyableStorage, throwOnCopyStrong) {
     ASSERT_EQ(Bomb::cnt, 0);
 }
 
+struct FlakyCopy {
+    int i;
+    inline static int cnt = 0;
+    inline static int copiesLeft = 0;
+    FlakyCopy(int i) : i(i) { cnt++; }
+    FlakyCopy(const FlakyCopy& other) : i(other.i) {
+        if (copiesLeft-- == 0)
+            throw std::runtime_error("Copy construction failed.");
+        cnt++;
+    }
+    ~FlakyCopy() { cnt--; }
+};
+
+TEST(BatchedOps, copyDestroysTheMadeObjectsIfACopyThrows) {
+    using Storage = Any<>;
+    constexpr size_t N = 4;
+    std::allocator<Storage> alloc;
+    Storage* src = alloc.allocate(N);
+    Storage* copy = alloc.allocate(N);
+    new (&src[0]) Storage{std::in_place_type<FlakyCopy>, 1};
+    new (&src[1]) Storage{2};
+    new (&src[2]) Storage{std::in_place_type<FlakyCopy>, 3};
+    new (&src[3]) Storage{std::in_place_type<FlakyCopy>, 4};
+
+    // The last run throws halfway.
+    FlakyCopy::copiesLeft = 2;
+    ASSERT_THROW(woid::uninitialized_copy_n(src, N, copy), std::runtime_error);
+    ASSERT_EQ(FlakyCopy::cnt, 3);
+    woid::destroy_n(src, N);
+    ASSERT_EQ(FlakyCopy::cnt, 0);
+
+    alloc.deallocate(src, N);
+    alloc.deallocate(copy, N);
+}
+
 constexpr auto SafeAnyCastTestCases = hana::filter(MoveTestCases, [](auto testCase) {
     using S = decltype(testCase)::type::Storage;
     return hana::bool_c < S::kSafeAnyCast == SafeAnyCast::ENABLED > ;
@@ -0,0 +1,16 @@
+#include "cross_tu_hidden_lib.hpp"
+
+template <typename Storage, typename IntType>
+__attribute__((visibility("default"))) Storage mkHiddenAny(int i) {
+    return Storage{std::in_place_type<IntType>, i};
+}
+
+template __attribute__((visibility("default"))) NamedAnyMoveOnly
+mkHiddenAny<NamedAnyMoveOnly, int32_t>(int i);
+template __attribute__((visibility("default"))) NamedAnyMoveOnly
+mkHiddenAny<NamedAnyMoveOnly, __int128>(int i);
+
+template __attribute__((visibility("default"))) NamedAnyCopyable
+mkHiddenAny<NamedAnyCopyable, int32_t>(int i);
+template __attribute__((visibility("default"))) NamedAnyCopyable
+mkHiddenAny<NamedAnyCopyable, __int128>(int i);
@@ -0,0 +1,18 @@
+#include "woid.hpp"
+#include <cstdint>
+
+// Unlike `CrossTuLib`, `CrossTuHiddenLib` keeps Woid's symbols hidden, so its MemManagers are
+// copies of ours at other addresses. Only the type names tell them apart.
+template <woid::Copy kCopy>
+using NamedAny8 = woid::Any<8,
+                            kCopy,
+                            woid::ExceptionGuarantee::NONE,
+                            alignof(void*),
+                            woid::FunPtr::COMBINED,
+                            woid::SafeAnyCast::TYPE_NAME>;
+
+using NamedAnyMoveOnly = NamedAny8<woid::Copy::DISABLED>;
+using NamedAnyCopyable = NamedAny8<woid::Copy::ENABLED>;
+
+template <typename Storage, typename IntType>
+__attribute__((visibility("default"))) Storage mkHiddenAny(int i);
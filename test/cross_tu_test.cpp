@@ -1,5 +1,6 @@
 #define BOOST_TEST_MODULE CrossTuTest
 
+#include "cross_tu_hidden_lib.hpp"
 #include "cross_tu_lib.hpp"
 #include "woid.hpp"
 #include <boost/hana.hpp>
@@ -23,6 +24,12 @@ constexpr static auto TestCases
     = hana::transform(hana::cartesian_product(hana::make_tuple(SafeStorages, IntTypes)),
                       hana::fuse(hana::template_<TestCase>));
 
+constexpr static auto NamedStorages = hana::tuple_t<NamedAnyMoveOnly, NamedAnyCopyable>;
+
+constexpr static auto NamedTestCases
+    = hana::transform(hana::cartesian_product(hana::make_tuple(NamedStorages, IntTypes)),
+                      hana::fuse(hana::template_<TestCase>));
+
 template <auto HanaTuple>
 using AsTuple = decltype(hana::unpack(HanaTuple, hana::template_<testing::Types>))::type;
 
@@ -53,3 +60,33 @@ TYPED_TEST(SafeAnyCastTest, SafeAnyCastThrowsWhenTypeMismatches) {
 }
 
 #endif
+
+template <typename T>
+struct TypeNameSafeAnyCastTest : testing::Test {};
+
+TYPED_TEST_SUITE(TypeNameSafeAnyCastTest, AsTuple<NamedTestCases>);
+
+TYPED_TEST(TypeNameSafeAnyCastTest, SafeAnyCastWorksAcrossHiddenSymbols) {
+    using Storage = TypeParam::Storage;
+    using Value = TypeParam::Value;
+
+    auto any = mkHiddenAny<Storage, Value>(kInt);
+    ASSERT_EQ(any_cast<Value>(any), kInt);
+    ASSERT_EQ(any_cast<Value&>(any), kInt);
+    ASSERT_EQ(any_cast<const Value&>(any), kInt);
+    ASSERT_NE(woid::try_cast<Value>(any), nullptr);
+    ASSERT_EQ(woid::try_cast<float>(any), nullptr);
+    ASSERT_EQ(any_cast<Value&&>(std::move(any)), kInt);
+}
+
+#if defined(__cpp_exceptions)
+
+TYPED_TEST(TypeNameSafeAnyCastTest, SafeAnyCastThrowsWhenTypeMismatches) {
+    using Storage = TypeParam::Storage;
+    using Value = TypeParam::Value;
+
+    auto any = mkHiddenAny<Storage, Value>(kInt);
+    EXPECT_THROW(any_cast<float>(any), woid::BadAnyCast);
+}
+
+#endif
@@ -1,6 +1,7 @@
 #define BOOST_TEST_MODULE FunTest
 
 #include "storage_test_setup.hpp"
+#include "woid_cpu_dispatch.hpp"
 
 template <typename T>
 struct MoveStorageTypes : testing::Test, AlternativeAllocatorResetter {};
@@ -108,6 +109,39 @@ TYPED_TEST(StorageType, canCallConstMethod) {
     ASSERT_EQ(f(&i, 5), 3 + 5);
 }
 
+constexpr auto kScalarPlus = [](int x, int y) { return x + y; };
+constexpr auto kAvx2Plus = [](int x, int y) { return 100 + x + y; };
+using PlusDispatch = CpuDispatch<kScalarPlus, kScalarPlus, kAvx2Plus>;
+
+TYPED_TEST(StorageType, callsTheImplementationOfTheForcedCpuLevel) {
+    using Storage = TypeParam;
+    using F = Fun<Storage, int(int, int) const>;
+    ASSERT_EQ(F{PlusDispatch{CpuLevel::SCALAR}}(2, 5), 7);
+    ASSERT_EQ(F{PlusDispatch{CpuLevel::SSE42}}(2, 5), 7);
+    ASSERT_EQ(F{PlusDispatch{CpuLevel::AVX2}}(2, 5), 107);
+    ASSERT_EQ(F{PlusDispatch{CpuLevel::AVX512}}(2, 5), 107);
+}
+
+TEST(CpuDispatch, isNotStoredInTheFun) {
+    static_assert(!detail::kIsStateless<PlusDispatch>);
+    using F = Fun<Any<8>, int(int, int) const>;
+    const F f{PlusDispatch{CpuLevel::AVX2}};
+    ASSERT_EQ(f.storage.getManager(), nullptr);
+    F copy{f};
+    ASSERT_EQ(copy.storage.getManager(), nullptr);
+    ASSERT_EQ(copy(2, 5), 107);
+
+    const Fun<TrivialAny<>, int(int, int) const> trivial{PlusDispatch{CpuLevel::SCALAR}};
+    auto trivialCopy = trivial;
+    ASSERT_EQ(trivialCopy(2, 5), 7);
+}
+
+TEST(CpuDispatch, isCallableOnItsOwn) {
+    ASSERT_EQ(PlusDispatch{CpuLevel::SCALAR}(2, 5), 7);
+    ASSERT_EQ(PlusDispatch{CpuLevel::AVX512}(2, 5), 107);
+    ASSERT_LE(PlusDispatch{}.level, CpuLevel::AVX512);
+}
+
 struct MoveOnlyFunctor {
     constexpr MoveOnlyFunctor() = default;
     MoveOnlyFunctor(const MoveOnlyFunctor&) = delete;
@@ -137,3 +171,78 @@ TEST(FunRef, canCall) {
     static_assert(IsMovableAndCopyable<F>);
     ASSERT_EQ(fRef(2, 5), doubleAdd(2, 5));
 }
+
+TEST(Fun, callsStatelessCallablesWithoutReadingTheStorage) {
+    static_assert(detail::kIsStateless<std::less<int>>);
+    static_assert(!detail::kIsStateless<bool (*)(int, int)>);
+
+    using F = Fun<Any<8>, bool(int, int) const>;
+    const F less{std::less<int>{}};
+    ASSERT_EQ(less.storage.getManager(), nullptr);
+    F copy{less};
+    ASSERT_EQ(copy.storage.getManager(), nullptr);
+    ASSERT_TRUE(copy(1, 2));
+    ASSERT_FALSE(copy(2, 1));
+    F moved{std::move(copy)};
+    ASSERT_TRUE(moved(1, 2));
+
+    ASSERT_EQ(moved.storage.getManager(), nullptr);
+
+    // A function pointer is stored, yet copying it is a memcpy.
+    F fnPtr{+[](int a, int b) { return a > b; }};
+    ASSERT_NE(fnPtr.storage.getManager(), nullptr);
+    F fnPtrCopy{fnPtr};
+    fnPtr = less;
+    ASSERT_EQ(fnPtr.storage.getManager(), nullptr);
+    ASSERT_TRUE(fnPtrCopy(2, 1));
+    ASSERT_TRUE(fnPtr(1, 2));
+
+    int calls = 0;
+    auto counting = [&calls](int a, int b) {
+        ++calls;
+        return a < b;
+    };
+    static_assert(!detail::kIsStateless<decltype(counting)>);
+    F stateful{counting};
+    ASSERT_TRUE(stateful(1, 2));
+    ASSERT_EQ(calls, 1);
+}
+
+struct CountingAllocator {
+    inline static int made = 0;
+
+    template <typename T>
+    static T* make(auto&&... args) {
+        made++;
+        return DefaultAllocator::make<T>(std::forward<decltype(args)>(args)...);
+    }
+
+    template <typename T>
+    static void del(T* obj) noexcept {
+        DefaultAllocator::del(obj);
+    }
+};
+
+TEST(Fun, allocatesNothingForStatelessCallables) {
+    constexpr auto kHeapStorages = hana::tuple_t<DynamicAny<Copy::ENABLED, CountingAllocator>,
+                                                 ThinDynamicAny<Copy::ENABLED, CountingAllocator>,
+                                                 Box<Copy::ENABLED, CountingAllocator>,
+                                                 CowAny<RefCount::ATOMIC, CountingAllocator>>;
+    hana::for_each(kHeapStorages, [](auto storage) {
+        using F = Fun<typename decltype(storage)::type, bool(int, int) const>;
+        CountingAllocator::made = 0;
+        const F less{std::less<int>{}};
+        F copy{less};
+        F moved{std::move(copy)};
+        moved = less;
+        EXPECT_TRUE(moved(1, 2));
+        EXPECT_EQ(CountingAllocator::made, 0);
+
+        const F greater{[](int a, int b) { return a > b; }};
+        EXPECT_TRUE(greater(2, 1));
+        EXPECT_EQ(CountingAllocator::made, 0);
+        const F stateful{[offset = 1](int a, int b) { return a + offset < b; }};
+        EXPECT_TRUE(stateful(1, 3));
+        EXPECT_EQ(CountingAllocator::made, 1);
+    });
+}
@@ -72,20 +72,36 @@ constexpr auto Storages = hana::tuple_t<woid::Any<8, Copy::ENABLED>,
                                         woid::Any<8, Copy::DISABLED>,
                                         DynamicAny<Copy::ENABLED>,
                                         DynamicAny<Copy::DISABLED>,
+                                        CowAny<>,
                                         std::any>;
 constexpr auto VTableOwnerships
     = hana::tuple_c<VTableOwnership, VTableOwnership::DEDICATED, VTableOwnership::SHARED>;
 constexpr auto Interfaces = hana::tuple_t<InterfaceViaFuns, InterfaceViaMethods>;
 
-constexpr auto TestCases
-    = hana::concat(hana::transform(hana::cartesian_product(
-                                       hana::make_tuple(Interfaces, VTableOwnerships, Storages)),
-                                   hana::fuse([](auto i, auto v, auto s) {
-                                       return hana::type_c<IncAndTwice<typename decltype(i)::type,
-                                                                       decltype(v)::value,
-                                                                       typename decltype(s)::type>>;
-                                   })),
-                   hana::tuple_t<SealedIncAndTwice>);
+// The unified vtable lives in the MemManager slot, hence it's for `Any` and `Box` only.
+constexpr auto UnifiedStorages
+    = hana::tuple_t<woid::Any<8, Copy::ENABLED>,
+                    woid::Any<8, Copy::DISABLED>,
+                    woid::Any<8, Copy::ENABLED, ExceptionGuarantee::BASIC, 8, FunPtr::DEDICATED>,
+                    woid::Box<Copy::ENABLED>,
+                    woid::Box<Copy::DISABLED>>;
+
+constexpr auto mkIncAndTwice = hana::fuse([](auto i, auto v, auto s) {
+    return hana::type_c<
+        IncAndTwice<typename decltype(i)::type, decltype(v)::value, typename decltype(s)::type>>;
+});
+
+constexpr auto TestCases = hana::concat(
+    hana::concat(
+        hana::transform(
+            hana::cartesian_product(hana::make_tuple(Interfaces, VTableOwnerships, Storages)),
+            mkIncAndTwice),
+        hana::transform(hana::cartesian_product(hana::make_tuple(
+                            Interfaces,
+                            hana::tuple_c<VTableOwnership, VTableOwnership::UNIFIED>,
+                            UnifiedStorages)),
+                        mkIncAndTwice)),
+    hana::tuple_t<SealedIncAndTwice>);
 
 template <auto HanaTuple>
 using AsTuple = decltype(hana::unpack(HanaTuple, hana::template_<testing::Types>))::type;
@@ -112,6 +128,26 @@ TYPED_TEST(InterfaceTest, canCallMethods) {
     ASSERT_EQ(static_cast<const I&>(it).get(), 16);
 }
 
+TYPED_TEST(InterfaceTest, canCallMethodsByName) {
+    using I = TypeParam;
+
+    I it{C{}};
+    it.callByName("set", 3);
+    it.callByName("inc");
+    it.callByName("twice");
+
+    ASSERT_EQ(std::as_const(it).template callByName<size_t>("get"), 8);
+#if defined(__cpp_exceptions)
+    ASSERT_THROW(it.callByName("dec"), UnknownMethod);
+    ASSERT_THROW(it.callByName("inc", 1), UnknownMethod);
+    ASSERT_THROW(std::as_const(it).callByName("inc"), UnknownMethod);
+#else
+    ASSERT_DEATH(it.callByName("dec"), "");
+    ASSERT_DEATH(it.callByName("inc", 1), "");
+    ASSERT_DEATH(std::as_const(it).callByName("inc"), "");
+#endif
+}
+
 TYPED_TEST(InterfaceTest, andPutThemAllInVector) {
     using I = TypeParam;
 
@@ -131,6 +167,23 @@ TYPED_TEST(InterfaceTest, andPutThemAllInVector) {
     ASSERT_EQ(CC::cnt, 24);
 }
 
+TYPED_TEST(InterfaceTest, canEmplaceAnotherType) {
+    using I = TypeParam;
+
+    I it{C{}};
+    if constexpr (requires { it.template emplace<CC>(); }) {
+        it.template emplace<CC>();
+        it.inc();
+        ASSERT_EQ(static_cast<const I&>(it).get(), 2);
+        ASSERT_EQ(C::cnt, 0);
+
+        it.reset();
+        it.template emplace<C>();
+        it.inc();
+        ASSERT_EQ(C::cnt, 1);
+    }
+}
+
 constexpr auto VTableOwnderships
     = hana::tuple_c<VTableOwnership, VTableOwnership::SHARED, VTableOwnership::DEDICATED>;
 
@@ -249,3 +302,145 @@ TYPED_TEST(VTableParameterizedTest, propagatesConstRef) {
     ASSERT_EQ(g.template call<"addAll">(one, two, three, i, std::move(j)), 15);
     ASSERT_EQ(g.template call<"addAllFun">(one, two, three, i, std::move(j)), 15);
 }
+
+struct A {
+    int v;
+};
+
+struct B {
+    int v;
+};
+
+constexpr auto kLessSameType = [](const auto& a, const auto& b) -> bool { return a.v < b.v; };
+constexpr auto kLessCrossType = [](const auto&, const auto&) -> bool { return true; };
+
+template <VTableOwnership O>
+struct Ordered
+      : InterfaceBuilder::With<O>::template BinaryFun<"less", kLessSameType, kLessCrossType>::Build {
+    bool operator<(const Ordered& other) const { return this->template callBinary<"less">(other); }
+};
+
+constexpr auto AllVTableOwnerships = hana::tuple_c<VTableOwnership,
+                                                   VTableOwnership::SHARED,
+                                                   VTableOwnership::DEDICATED,
+                                                   VTableOwnership::UNIFIED>;
+
+template <typename T>
+struct BinaryFunTest : testing::Test {};
+
+TYPED_TEST_SUITE(BinaryFunTest, AsTuple<AllVTableOwnerships>);
+
+TYPED_TEST(BinaryFunTest, sameTypeOperandsGetTheSameTypeLambda) {
+    using I = Ordered<TypeParam::value>;
+    I one{A{1}};
+    I two{A{2}};
+    ASSERT_TRUE(one < two);
+    ASSERT_FALSE(two < one);
+    ASSERT_FALSE(one < one);
+}
+
+TYPED_TEST(BinaryFunTest, differentTypesFallBackToTheCrossTypeLambda) {
+    using I = Ordered<TypeParam::value>;
+    I one{A{1}};
+    I zero{B{0}};
+    ASSERT_TRUE(one < zero);
+    ASSERT_TRUE(zero < one);
+}
+
+struct Expensive {
+    int v;
+    int* evaluations;
+};
+
+constexpr auto kExpensiveValue = [](const auto& e) -> int {
+    ++*e.evaluations;
+    return e.v;
+};
+
+// clang-format off
+template <VTableOwnership O>
+using Cached = InterfaceBuilder::With<O>
+            ::template CachedFun<"value", kExpensiveValue>
+            ::template Fun<"set", [](auto& e, int v) -> void { e.v = v; }>::Build;
+// clang-format on
+
+template <typename T>
+struct CachedFunTest : testing::Test {};
+
+TYPED_TEST_SUITE(CachedFunTest, AsTuple<AllVTableOwnerships>);
+
+TYPED_TEST(CachedFunTest, evaluatesOnceUntilANonConstCall) {
+    int evaluations = 0;
+    Cached<TypeParam::value> c{Expensive{1, &evaluations}};
+    ASSERT_EQ(c.template call<"value">(), 1);
+    ASSERT_EQ(std::as_const(c).template call<"value">(), 1);
+    ASSERT_EQ(evaluations, 1);
+
+    c.template call<"set">(2);
+    ASSERT_EQ(c.template call<"value">(), 2);
+    ASSERT_EQ(c.template call<"value">(), 2);
+    ASSERT_EQ(evaluations, 2);
+}
+
+TEST(UnifiedVTableTest, costsOnePointerPerObject) {
+    static_assert(sizeof(GI<VTableOwnership::UNIFIED>) == sizeof(Any<8>));
+    static_assert(sizeof(GI<VTableOwnership::SHARED>) == sizeof(Any<8>) + sizeof(void*));
+}
+
+TEST(UnifiedVTableTest, overloadsAreResolved) {
+    GI<VTableOwnership::UNIFIED> g{G{}};
+    ASSERT_EQ(g.call<"get">(), 5);
+    ASSERT_TRUE(g.call<"isInt">(int{0}));
+    ASSERT_FALSE(g.call<"isIntFun">(float{0}));
+
+    const GI<VTableOwnership::UNIFIED> cg = g;
+    ASSERT_EQ(cg.call<"get">(), 45);
+    ASSERT_EQ(cg.call<"getFun">(), 45);
+
+    int i = 4;
+    int j = 5;
+    ASSERT_EQ(g.call<"addAll">(1, 2, 3, i, std::move(j)), 15);
+}
+
+TEST(BoxedInterfaceTest, isOnePointer) {
+    using I = InterfaceViaMethods::WithBoxedStorage<>::Build;
+    static_assert(sizeof(I) == sizeof(void*));
+
+    I i{C{}};
+    I j = i;
+    j.call<"set">(7);
+    ASSERT_EQ(std::as_const(i).call<"get">(), 7);
+}
+
+struct Square {
+    int side;
+    constexpr int area() const { return side * side; }
+};
+
+struct Rect {
+    int w;
+    int h;
+    constexpr int area() const { return w * h; }
+};
+
+constexpr auto kArea = [](const auto& shape) -> int { return shape.area(); };
+
+TEST(ConstexprInterfaceTest, sealedInterfaceIsAConstant) {
+    using I = SealedInterfaceBuilder<std::variant<Square, Rect>>::Fun<"area", kArea>::Build;
+    static constexpr std::array<I, 2> kShapes{I{Square{2}}, I{Rect{2, 3}}};
+    static_assert(kShapes[0].call<"area">() + kShapes[1].call<"area">() == 10);
+}
+
+#if WOID_CONSTEXPR_REF
+TEST(ConstexprInterfaceTest, interfaceOverCRefIsAConstant) {
+    using I = InterfaceBuilder::Fun<"area", kArea>::WithStorage<CRef>::Build;
+    static constexpr Square kSquare{2};
+    static constexpr Rect kRect{2, 3};
+    static constexpr std::array<I, 2> kShapes{I{kSquare}, I{kRect}};
+    static_assert(kShapes[0].call<"area">() + kShapes[1].call<"area">() == 10);
+
+    static constexpr auto kSix = [] { return 6; };
+    static constexpr FunRef<int() const> kFun{&kSix};
+    static_assert(kFun() == 6);
+}
+#endif
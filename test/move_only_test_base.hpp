@@ -79,6 +79,47 @@ TYPED_TEST_P(MoveTestCase, canSwapHeterogeneously) {
     ASSERT_EQ(any_cast<int>(otherStorage), 42);
 }
 
+template <typename It>
+concept HasWoidIterSwap = requires(It it) { woid::iter_swap(it, it); };
+
+TYPED_TEST_P(MoveTestCase, canSwapByAdlAndIterSwap) {
+    using Storage = TypeParam::Storage;
+    using Value = TypeParam::Value;
+    Storage storage(Value{kInt});
+    Storage otherStorage(int{42});
+
+    using std::swap;
+    swap(storage, otherStorage);
+    ASSERT_EQ(any_cast<Value&>(otherStorage).i, kInt);
+    ASSERT_EQ(any_cast<int>(storage), 42);
+
+    iter_swap(&storage, &otherStorage);
+    ASSERT_EQ(any_cast<Value&>(storage).i, kInt);
+    ASSERT_EQ(any_cast<int>(otherStorage), 42);
+
+    swap(storage, storage);
+    ASSERT_EQ(any_cast<Value&>(storage).i, kInt);
+
+    static_assert(!HasWoidIterSwap<std::pair<Storage, int>*>);
+}
+
+TYPED_TEST_P(MoveTestCase, canEmplaceAndReset) {
+    using Storage = TypeParam::Storage;
+    using Value = TypeParam::Value;
+    Storage storage(int{42});
+    auto& value = storage.template emplace<Value>(kInt);
+    ASSERT_EQ(value.i, kInt);
+    ASSERT_EQ(any_cast<Value&>(storage).i, kInt);
+
+    storage.template emplace<Value>(42);
+    ASSERT_EQ(any_cast<Value&>(storage).i, 42);
+
+    storage.reset();
+    storage.reset();
+    storage.template emplace<Value>(kInt);
+    ASSERT_EQ(any_cast<Value&>(storage).i, kInt);
+}
+
 TYPED_TEST_P(MoveTestCase, canGetByRef) {
     using Storage = TypeParam::Storage;
     using Value = TypeParam::Value;
@@ -122,6 +163,8 @@ REGISTER_TYPED_TEST_SUITE_P(MoveTestCase,
                             canMoveAssign,
                             canSwap,
                             canSwapHeterogeneously,
+                            canSwapByAdlAndIterSwap,
+                            canEmplaceAndReset,
                             canGetByRef,
                             canGetByRefRef,
                             canMoveAssignToMovedFrom,
@@ -138,4 +181,25 @@ TYPED_TEST_P(MoveTestCaseWithBigObject, canInstantiateFromPtr) {
     ASSERT_EQ(any_cast<Value&>(storage).i, kInt);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(MoveTestCaseWithBigObject, canInstantiateFromPtr);
+TYPED_TEST_P(MoveTestCaseWithBigObject, canConvertAdoptingTheBlock) {
+    using Storage = TypeParam::Storage;
+    using Value = TypeParam::Value;
+    using Dynamic = DynamicAny<Copy::DISABLED, typename Storage::Alloc>;
+    {
+        Storage storage(std::in_place_type<Value>, kInt);
+        auto* value = &any_cast<Value&>(storage);
+        auto dynamic = convert<Dynamic, Value>(std::move(storage));
+        ASSERT_EQ(any_cast<Value&>(dynamic).i, kInt);
+        if constexpr (requires { storage.template release<Value>(); }) {
+            ASSERT_EQ(&any_cast<Value&>(dynamic), value);
+        }
+
+        auto back = convert<Storage, Value>(std::move(dynamic));
+        ASSERT_EQ(any_cast<Value&>(back).i, kInt);
+    }
+    ASSERT_EQ(Value::cnt, 0);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(MoveTestCaseWithBigObject,
+                            canInstantiateFromPtr,
+                            canConvertAdoptingTheBlock);
@@ -96,16 +96,39 @@ static constexpr auto make_instantiations() {
                            mkAny);
 };
 
+// `STRONG_DOUBLE_BUFFER` only changes how an object is replaced, hence a couple of corners of the
+// matrix rather than the whole of it.
+template <Copy copy>
+constexpr auto DoubleBufferInstantiations
+    = hana::tuple_t<Any<8, copy, ExceptionGuarantee::STRONG_DOUBLE_BUFFER>,
+                    Any<80,
+                        copy,
+                        ExceptionGuarantee::STRONG_DOUBLE_BUFFER,
+                        alignof(__int128),
+                        FunPtr::DEDICATED,
+                        SafeAnyCast::ENABLED,
+                        AlternativeAllocator>>;
+
 constexpr auto MoveOnlyStorageTypes
-    = hana::concat(make_instantiations<Copy::DISABLED>(),
+    = hana::concat(hana::concat(make_instantiations<Copy::DISABLED>(),
+                                DoubleBufferInstantiations<Copy::DISABLED>),
                    hana::tuple_t<DynamicAny<Copy::DISABLED>,
                                  DynamicAny<Copy::DISABLED, AlternativeAllocator>,
+                                 ThinDynamicAny<Copy::DISABLED>,
+                                 ThinDynamicAny<Copy::DISABLED, AlternativeAllocator>,
+                                 Box<Copy::DISABLED>,
+                                 Box<Copy::DISABLED, AlternativeAllocator>,
                                  TrivialAny<8, Copy::DISABLED>,
                                  TrivialAny<8, Copy::DISABLED, 8, true, AlternativeAllocator>>);
 constexpr auto CopyStorageTypes
-    = hana::concat(make_instantiations<Copy::ENABLED>(),
+    = hana::concat(hana::concat(make_instantiations<Copy::ENABLED>(),
+                                DoubleBufferInstantiations<Copy::ENABLED>),
                    hana::tuple_t<DynamicAny<Copy::ENABLED>,
                                  DynamicAny<Copy::ENABLED, AlternativeAllocator>,
+                                 ThinDynamicAny<Copy::ENABLED>,
+                                 ThinDynamicAny<Copy::ENABLED, AlternativeAllocator>,
+                                 Box<Copy::ENABLED>,
+                                 Box<Copy::ENABLED, AlternativeAllocator>,
                                  TrivialAny<8, Copy::ENABLED>,
                                  TrivialAny<8, Copy::ENABLED, 8, true, AlternativeAllocator>>);
 
@@ -162,8 +185,13 @@ constexpr auto TrivialSmallValueTypes = hana::tuple_t<SmallInt>;
 constexpr auto ValueTypesToTestTrivialStorage
     = hana::concat(TrivialSmallValueTypes, hana::tuple_t<BigInt, NonTrivialInt>);
 
+// Copy-on-write clones a shared object by copying it, hence it holds copyable objects only.
+constexpr auto CowStorageTypes
+    = hana::tuple_t<CowAny<RefCount::ATOMIC>, CowAny<RefCount::NON_ATOMIC, AlternativeAllocator>>;
+
 constexpr auto CopyTypesCopyStorageTestCases = hana::flatten(
     hana::make_tuple(mkTestCases(CopyStorageTypes, CopyTypes),
+                     mkTestCases(CowStorageTypes, CopyTypes),
                      mkTestCases(TrivialStorageTypes, ValueTypesToTestTrivialStorage),
                      mkTestCases(TrivialNoAllocStorageTypes, TrivialSmallValueTypes)));
 constexpr auto MoveTestCases = hana::flatten(hana::make_tuple(
@@ -186,8 +214,8 @@ constexpr auto MoveTestCasesWithBigObject = hana::filter(MoveTestCases, [](auto
 template <auto HanaTuple>
 using AsTuple = decltype(hana::unpack(HanaTuple, hana::template_<testing::Types>))::type;
 
-constexpr auto AllStorages
-    = hana::flatten(hana::make_tuple(MoveOnlyStorageTypes, CopyStorageTypes, TrivialStorageTypes));
+constexpr auto AllStorages = hana::flatten(hana::make_tuple(
+    MoveOnlyStorageTypes, CopyStorageTypes, TrivialStorageTypes, CowStorageTypes));
 
 template <typename Value>
 struct ValueCntNuller : testing::Test {